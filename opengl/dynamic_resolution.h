@@ -0,0 +1,195 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <glad/glad.h>
+#include <cmath>
+#include <iostream>
+
+// Dynamiczna rozdzielczość renderowania.
+// Scena jest rysowana do pozaekranowego framebuffera, w prostokąt o boku
+// scale * rozmiar okna, a potem rozciągana na okno przez glBlitFramebuffer
+// z filtrem liniowym. Czas GPU każdej klatki jest mierzony zapytaniami
+// GL_TIME_ELAPSED; skala jest dobierana tak, żeby zbliżać się do docelowego
+// czasu klatki. Framebuffer ma rozmiar okna, więc zmiana skali nie wymaga
+// realokacji, tylko innego viewportu.
+//
+// Użycie w pętli renderowania:
+//   dynRes.begin();   // zamiast glViewport, przed glClear
+//   ... rysowanie ...
+//   dynRes.end();     // przed glfwSwapBuffers
+class DynamicResolution
+{
+public:
+    static const int QUERY_COUNT = 4;
+
+    DynamicResolution() : fbo(0), color(0), depth(0), windowWidth(0), windowHeight(0),
+        targetMs(16.0f), minScale(0.5f), currentScale(1.0f), lastGpuMs(0.0f),
+        queryHead(0), queriesPending(0), queryActive(false)
+    {
+        for (int i = 0; i < QUERY_COUNT; i++)
+            queries[i] = 0;
+    }
+
+    // targetFrameMs: docelowy czas GPU klatki; minimalScale: najmniejsza dopuszczalna skala
+    bool init(int width, int height, float targetFrameMs, float minimalScale = 0.5f)
+    {
+        // ujemny cel dałby sqrt z liczby ujemnej (NaN w skali i rozmiarze viewportu), zerowy
+        // przypiąłby skalę do minimum
+        if (!std::isfinite(targetFrameMs) || targetFrameMs <= 0.0f)
+        {
+            std::cout << "BŁĄD::DYNAMIC_RESOLUTION::NIEPRAWIDŁOWY_CEL " << targetFrameMs << " ms" << std::endl;
+            return false;
+        }
+        if (!(minimalScale > 0.0f && minimalScale <= 1.0f))
+        {
+            std::cout << "BŁĄD::DYNAMIC_RESOLUTION::NIEPRAWIDŁOWA_SKALA " << minimalScale << std::endl;
+            return false;
+        }
+        targetMs = targetFrameMs;
+        minScale = minimalScale;
+        glGenQueries(QUERY_COUNT, queries);
+        return resize(width, height);
+    }
+
+    // wywoływane z funkcji zmiany rozmiaru okna (hostFramebufferSize w host.h)
+    bool resize(int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+            return true;
+        windowWidth = width;
+        windowHeight = height;
+
+        if (fbo == 0)
+        {
+            glGenFramebuffers(1, &fbo);
+            glGenTextures(1, &color);
+            glGenRenderbuffers(1, &depth);
+        }
+        glBindTexture(GL_TEXTURE_2D, color);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete)
+            std::cout << "BŁĄD::FRAMEBUFFER::NIEKOMPLETNY" << std::endl;
+        return complete;
+    }
+
+    void begin()
+    {
+        collectTimings();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, renderWidth(), renderHeight());
+        // glClear ma czyścić tylko używany prostokąt
+        glScissor(0, 0, renderWidth(), renderHeight());
+        glEnable(GL_SCISSOR_TEST);
+
+        if (queriesPending < QUERY_COUNT)
+        {
+            glBeginQuery(GL_TIME_ELAPSED, queries[(queryHead + queriesPending) % QUERY_COUNT]);
+            queryActive = true;
+        }
+        else
+            queryActive = false;
+    }
+
+    void end()
+    {
+        if (queryActive)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            queriesPending++;
+        }
+
+        // skalowanie do rozmiaru okna
+        glDisable(GL_SCISSOR_TEST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, renderWidth(), renderHeight(), 0, 0, windowWidth, windowHeight,
+            GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, windowWidth, windowHeight);
+    }
+
+    float scale() const { return currentScale; }
+    float gpuMs() const { return lastGpuMs; }
+    int renderWidth() const { return scaled(windowWidth); }
+    int renderHeight() const { return scaled(windowHeight); }
+
+    void destroy()
+    {
+        glDeleteQueries(QUERY_COUNT, queries);
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &color);
+        glDeleteRenderbuffers(1, &depth);
+        fbo = color = depth = 0;
+    }
+
+private:
+    GLuint fbo, color, depth;
+    int windowWidth, windowHeight;
+    float targetMs;
+    float minScale;
+    float currentScale;
+    float lastGpuMs;
+    GLuint queries[QUERY_COUNT];
+    int queryHead;
+    int queriesPending;
+    bool queryActive;
+
+    int scaled(int size) const
+    {
+        int s = (int)(size * currentScale + 0.5f);
+        return s > 0 ? s : 1;
+    }
+
+    // odczyt gotowych zapytań (bez czekania na GPU) i korekta skali
+    void collectTimings()
+    {
+        while (queriesPending > 0)
+        {
+            GLuint query = queries[queryHead];
+            GLint available = 0;
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+            queryHead = (queryHead + 1) % QUERY_COUNT;
+            queriesPending--;
+
+            lastGpuMs = ns / 1000000.0f;
+            adjust(lastGpuMs);
+        }
+    }
+
+    // koszt jest w przybliżeniu proporcjonalny do liczby pikseli, czyli do scale^2;
+    // krok jest tłumiony, a mała strefa martwa zapobiega oscylacjom
+    void adjust(float gpuTimeMs)
+    {
+        if (gpuTimeMs <= 0.0f)
+            return;
+        float ratio = targetMs / gpuTimeMs;
+        if (ratio > 0.95f && ratio < 1.05f)
+            return;
+        float ideal = currentScale * std::sqrt(ratio);
+        float next = currentScale + (ideal - currentScale) * 0.25f;
+        if (!(next >= minScale)) // także NaN
+            next = minScale;
+        if (next > 1.0f)
+            next = 1.0f;
+        currentScale = next;
+    }
+};
+
+#endif
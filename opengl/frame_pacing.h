@@ -0,0 +1,313 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "trace.h"
+
+// Tempo klatek i pomiar opóźnienia od wejścia do wymiany buforów.
+//
+// glfwSwapBuffers zwykle wraca od razu, a sterownik kolejkuje kilka klatek;
+// wejście odczytane na początku klatki trafia wtedy na ekran kilka klatek
+// później. FramePacer stawia fence za każdą wymianą buforów i przed kolejną
+// klatką czeka na fence sprzed `limit` klatek, więc CPU nie wyprzedza GPU
+// o więcej niż tyle klatek. W trybie późnego wejścia zdarzenia są odpytywane
+// dopiero po tym czekaniu, tuż przed wysłaniem rysowania.
+//
+// Użycie w pętli renderowania:
+//   pacer.beginFrame();            // czekanie na GPU, przed pierwszym poleceniem GL klatki
+//   ... praca CPU ...
+//   if (pacer.lateInput())
+//       glfwPollEvents();
+//   processInput(window);
+//   ... rysowanie ...
+//   glfwSwapBuffers(window);
+//   pacer.endFrame();              // fence i znacznik czasu GPU za wymianą
+//   if (!pacer.lateInput())
+//       glfwPollEvents();          // zawsze po endFrame()
+//
+// Opóźnienie jest liczone od chwili, w której GLFW dostarczyło zdarzenie
+// (klawisz, przycisk, ruch myszy, kółko) do chwili, w której GPU doszło do
+// zapytania GL_TIMESTAMP postawionego za glfwSwapBuffers. Czas od zdarzenia
+// w systemie do glfwPollEvents nie jest znany, więc do wyniku trzeba doliczyć
+// do jednego odstępu między odpytaniami. Zdarzenia dostarczone od poprzedniego
+// endFrame() są przypisane do bieżącej klatki; liczy się najstarsze z nich.
+//
+// Zmienne środowiskowe:
+//   LOW_LATENCY=1         limit 1 klatki w locie, późne wejście i statystyki
+//   FRAMES_IN_FLIGHT=n    limit klatek w locie (0 = bez limitu, najwyżej 4)
+//   LATENCY_STATS=1       statystyki co sekundę także bez LOW_LATENCY
+class FramePacer
+{
+public:
+    static const int SLOTS = 4;
+
+    FramePacer() : window(NULL), limit(0), late(false), stats(false), timestamps(false),
+        gpuOffset(0), frameIndex(0), pendingInput(0), previousKey(NULL), previousButton(NULL),
+        previousCursor(NULL), previousScroll(NULL)
+    {
+        resetStats();
+        for (int i = 0; i < SLOTS; i++)
+        {
+            frames[i].fence = 0;
+            frames[i].query = 0;
+            frames[i].input = 0;
+        }
+    }
+
+    // po utworzeniu kontekstu; przejmuje wskaźnik użytkownika okna i wywołania
+    // zwrotne wejścia (poprzednie wywołania zwrotne są dalej wołane)
+    bool init(GLFWwindow* pacedWindow)
+    {
+        window = pacedWindow;
+        if (const char* env = getenv("LOW_LATENCY"))
+        {
+            if (atoi(env) != 0)
+            {
+                limit = 1;
+                late = true;
+                stats = true;
+            }
+        }
+        if (const char* env = getenv("FRAMES_IN_FLIGHT"))
+        {
+            int n = atoi(env);
+            limit = n < 0 ? 0 : (n > SLOTS ? SLOTS : n);
+        }
+        if (const char* env = getenv("LATENCY_STATS"))
+            stats = atoi(env) != 0;
+
+        for (int i = 0; i < SLOTS; i++)
+            glGenQueries(1, &frames[i].query);
+
+        // bez licznika znaczników czasu nadal działa limit, tylko bez pomiaru
+        GLint bits = 0;
+        glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+        timestamps = bits > 0;
+        if (timestamps)
+        {
+            glFinish();
+            GLint64 gpuNow = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+            gpuOffset = nowNs() - (int64_t)gpuNow;
+        }
+
+        if (glfwGetWindowUserPointer(window) != NULL)
+            std::cout << "BŁĄD::FRAME_PACING::WSKAŹNIK_OKNA_ZAJĘTY (brak pomiaru opóźnienia)" << std::endl;
+        else
+        {
+            glfwSetWindowUserPointer(window, this);
+            previousKey = glfwSetKeyCallback(window, keyCallback);
+            previousButton = glfwSetMouseButtonCallback(window, buttonCallback);
+            previousCursor = glfwSetCursorPosCallback(window, cursorCallback);
+            previousScroll = glfwSetScrollCallback(window, scrollCallback);
+        }
+
+        std::cout << "Klatki w locie: ";
+        if (limit > 0)
+            std::cout << "najwyżej " << limit;
+        else
+            std::cout << "bez limitu";
+        std::cout << ", wejście " << (late ? "tuż przed rysowaniem" : "po wymianie buforów") << std::endl;
+        statStart = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool lateInput() const { return late; }
+
+    // czekanie, aż GPU skończy klatkę sprzed `limit` klatek
+    void beginFrame()
+    {
+        if (limit == 0 || frameIndex < (uint64_t)limit)
+            return;
+        Frame& f = frames[(frameIndex - limit) % SLOTS];
+        if (f.fence == 0)
+            return;
+        TRACE_ZONE("czekanie na GPU");
+        int64_t start = nowNs();
+        for (;;)
+        {
+            GLenum r = glClientWaitSync(f.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+            if (r == GL_ALREADY_SIGNALED || r == GL_CONDITION_SATISFIED || r == GL_WAIT_FAILED)
+                break;
+        }
+        waitNs += nowNs() - start;
+    }
+
+    // zaraz po glfwSwapBuffers
+    void endFrame()
+    {
+        Frame& f = frames[frameIndex % SLOTS];
+        if (f.fence)
+            resolve(f);
+        if (timestamps)
+            glQueryCounter(f.query, GL_TIMESTAMP);
+        f.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        f.input = pendingInput;
+        pendingInput = 0;
+        frameIndex++;
+        statFrames++;
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - statStart).count();
+        if (elapsed >= 1.0)
+        {
+            if (stats)
+                printStats();
+            resetStats();
+            statStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    void destroy()
+    {
+        for (int i = 0; i < SLOTS; i++)
+        {
+            if (frames[i].fence)
+                glDeleteSync(frames[i].fence);
+            if (frames[i].query)
+                glDeleteQueries(1, &frames[i].query);
+            frames[i].fence = 0;
+            frames[i].query = 0;
+        }
+        if (window && glfwGetWindowUserPointer(window) == this)
+        {
+            glfwSetKeyCallback(window, previousKey);
+            glfwSetMouseButtonCallback(window, previousButton);
+            glfwSetCursorPosCallback(window, previousCursor);
+            glfwSetScrollCallback(window, previousScroll);
+            glfwSetWindowUserPointer(window, NULL);
+        }
+    }
+
+private:
+    struct Frame
+    {
+        GLsync fence;
+        GLuint query;   // GL_TIMESTAMP za wymianą buforów
+        int64_t input;  // najstarsze zdarzenie wejścia tej klatki, ns; 0 = brak
+    };
+
+    GLFWwindow* window;
+    int limit;
+    bool late, stats, timestamps;
+    int64_t gpuOffset; // czas CPU - czas GPU, w ns
+    Frame frames[SLOTS];
+    uint64_t frameIndex;
+    int64_t pendingInput;
+
+    GLFWkeyfun previousKey;
+    GLFWmousebuttonfun previousButton;
+    GLFWcursorposfun previousCursor;
+    GLFWscrollfun previousScroll;
+
+    // statystyki bieżącej sekundy
+    std::chrono::steady_clock::time_point statStart;
+    int statFrames, samples, dropped;
+    int64_t latencySumNs, latencyMaxNs, waitNs;
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void resetStats()
+    {
+        statFrames = samples = dropped = 0;
+        latencySumNs = latencyMaxNs = waitNs = 0;
+    }
+
+    // odczyt klatki, której slot ma być użyty ponownie; bez czekania
+    void resolve(Frame& f)
+    {
+        GLenum r = glClientWaitSync(f.fence, 0, 0);
+        bool done = r == GL_ALREADY_SIGNALED || r == GL_CONDITION_SATISFIED;
+        if (f.input && timestamps)
+        {
+            if (done)
+            {
+                GLuint64 gpuTime = 0;
+                glGetQueryObjectui64v(f.query, GL_QUERY_RESULT, &gpuTime);
+                int64_t latency = (int64_t)gpuTime + gpuOffset - f.input;
+                if (latency < 0)
+                    latency = 0;
+                latencySumNs += latency;
+                if (latency > latencyMaxNs)
+                    latencyMaxNs = latency;
+                samples++;
+            }
+            else
+                dropped++; // bez limitu GPU może być dalej niż SLOTS klatek w tyle
+        }
+        glDeleteSync(f.fence);
+        f.fence = 0;
+        f.input = 0;
+    }
+
+    void printStats()
+    {
+        char line[200];
+        if (samples > 0)
+            snprintf(line, sizeof(line), "Opóźnienie wejście->wymiana: śr %.1f ms, max %.1f ms (%d klatek z wejściem",
+                latencySumNs / 1e6 / samples, latencyMaxNs / 1e6, samples);
+        else
+            snprintf(line, sizeof(line), "Opóźnienie wejście->wymiana: brak zdarzeń (0 klatek z wejściem");
+        std::cout << line;
+        if (dropped > 0)
+            std::cout << ", " << dropped << " pominiętych";
+        snprintf(line, sizeof(line), "), czekanie na GPU %.2f ms/klatkę", statFrames > 0 ? waitNs / 1e6 / statFrames : 0.0);
+        std::cout << line << std::endl;
+    }
+
+    void recordInput()
+    {
+        if (pendingInput == 0)
+            pendingInput = nowNs();
+    }
+
+    static FramePacer* pacerOf(GLFWwindow* w)
+    {
+        return (FramePacer*)glfwGetWindowUserPointer(w);
+    }
+
+    static void keyCallback(GLFWwindow* w, int key, int scancode, int action, int mods)
+    {
+        FramePacer* p = pacerOf(w);
+        if (action != GLFW_RELEASE)
+            p->recordInput();
+        if (p->previousKey)
+            p->previousKey(w, key, scancode, action, mods);
+    }
+
+    static void buttonCallback(GLFWwindow* w, int button, int action, int mods)
+    {
+        FramePacer* p = pacerOf(w);
+        if (action == GLFW_PRESS)
+            p->recordInput();
+        if (p->previousButton)
+            p->previousButton(w, button, action, mods);
+    }
+
+    static void cursorCallback(GLFWwindow* w, double x, double y)
+    {
+        FramePacer* p = pacerOf(w);
+        p->recordInput();
+        if (p->previousCursor)
+            p->previousCursor(w, x, y);
+    }
+
+    static void scrollCallback(GLFWwindow* w, double x, double y)
+    {
+        FramePacer* p = pacerOf(w);
+        p->recordInput();
+        if (p->previousScroll)
+            p->previousScroll(w, x, y);
+    }
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <glad/glad.h>
+#include <iostream>
+
+// Pierścieniowy bufor uniformów na dane per-klatka i per-rysowanie.
+// Jeden duży UBO jest podzielony na FRAMES_IN_FLIGHT regionów. W każdej klatce
+// dane kolejnych wywołań rysowania są dopisywane liniowo do bieżącego regionu,
+// a potem podpinane przez glBindBufferRange zamiast serii glUniform*.
+// Fence wstawiany na końcu klatki pilnuje, żeby CPU nie nadpisał regionu,
+// którego GPU jeszcze nie skończył czytać.
+//
+// Użycie w pętli renderowania:
+//   ring.beginFrame();
+//   FrameUniformRing::Allocation a = ring.allocate(sizeof(dane)); memcpy(a.ptr, ...);
+//   ring.flush();             // przed pierwszym rysowaniem
+//   ring.bind(0, a); glDraw...;
+//   ring.endFrame();          // po ostatnim rysowaniu
+class FrameUniformRing
+{
+public:
+    static const unsigned int FRAMES_IN_FLIGHT = 3;
+
+    struct Allocation
+    {
+        void* ptr;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    FrameUniformRing() : ubo(0), regionSize(0), alignment(256), frame(0), head(0),
+        mapped(NULL), persistent(false)
+    {
+        for (unsigned int i = 0; i < FRAMES_IN_FLIGHT; i++)
+            fences[i] = 0;
+    }
+
+    // alokacja bufora; bytesPerFrame to budżet danych na jedną klatkę
+    bool init(GLsizeiptr bytesPerFrame)
+    {
+        GLint align = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+        if (align > 0)
+            alignment = align;
+        regionSize = alignUp(bytesPerFrame);
+        GLsizeiptr total = regionSize * FRAMES_IN_FLIGHT;
+
+        glGenBuffers(1, &ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+#ifdef GL_MAP_PERSISTENT_BIT
+        // GL 4.4+: bufor zmapowany na stałe, bez map/unmap w każdej klatce
+        if (GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4))
+        {
+            glBufferStorage(GL_UNIFORM_BUFFER, total, NULL, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT);
+            mapped = (unsigned char*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, total,
+                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+            persistent = mapped != NULL;
+            if (!persistent)
+            {
+                // bufor z glBufferStorage jest niezmienny: glBufferData na nim to
+                // GL_INVALID_OPERATION, więc ścieżka 3.3 dostaje nowy bufor
+                // (glGetError kasuje błąd nieudanego mapowania)
+                glBindBuffer(GL_UNIFORM_BUFFER, 0);
+                glDeleteBuffers(1, &ubo);
+                glGetError();
+                glGenBuffers(1, &ubo);
+                glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+            }
+        }
+#endif
+        if (!persistent)
+            glBufferData(GL_UNIFORM_BUFFER, total, NULL, GL_STREAM_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        if (persistent)
+            return true;
+        if (glGetError() != GL_NO_ERROR)
+        {
+            std::cout << "BŁĄD::UBO::ALOKACJA_NIEUDANA" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // czeka, aż GPU zwolni region tej klatki; w ścieżce 3.3 mapuje go bez synchronizacji
+    void beginFrame()
+    {
+        if (fences[frame])
+        {
+            GLenum status = glClientWaitSync(fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            while (status == GL_TIMEOUT_EXPIRED)
+                status = glClientWaitSync(fences[frame], 0, 1000000);
+            glDeleteSync(fences[frame]);
+            fences[frame] = 0;
+        }
+        head = 0;
+
+        if (!persistent)
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+            mapped = (unsigned char*)glMapBufferRange(GL_UNIFORM_BUFFER, regionOffset(), regionSize,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+    }
+
+    // liniowa suballokacja w regionie bieżącej klatki; gdy region jest pełny,
+    // ptr == NULL i size == 0 (bind() takiej alokacji niczego nie podpina)
+    Allocation allocate(GLsizeiptr size)
+    {
+        Allocation a = { NULL, 0, 0 };
+        GLsizeiptr aligned = alignUp(size);
+        if (mapped == NULL || head + aligned > regionSize)
+        {
+            std::cout << "BŁĄD::UBO::REGION_PRZEPEŁNIONY" << std::endl;
+            return a;
+        }
+        a.offset = regionOffset() + head;
+        a.ptr = persistent ? mapped + a.offset : mapped + head;
+        a.size = size;
+        head += aligned;
+        return a;
+    }
+
+    // udostępnienie zapisanych danych GPU; wywołać raz, przed pierwszym rysowaniem w klatce
+    void flush()
+    {
+        if (mapped == NULL)
+            return;
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+        if (persistent)
+        {
+            if (head > 0)
+                glFlushMappedBufferRange(GL_UNIFORM_BUFFER, regionOffset(), head);
+        }
+        else
+        {
+            if (head > 0)
+                glFlushMappedBufferRange(GL_UNIFORM_BUFFER, 0, head);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            mapped = NULL;
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void bind(GLuint binding, const Allocation& a)
+    {
+        if (a.size == 0)
+            return;
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, ubo, a.offset, a.size);
+    }
+
+    // fence za ostatnim rysowaniem korzystającym z regionu i przejście do następnego
+    void endFrame()
+    {
+        fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frame = (frame + 1) % FRAMES_IN_FLIGHT;
+    }
+
+    GLuint buffer() const { return ubo; }
+    GLsizeiptr sizeBytes() const { return regionSize * FRAMES_IN_FLIGHT; }
+
+    void destroy()
+    {
+        for (unsigned int i = 0; i < FRAMES_IN_FLIGHT; i++)
+        {
+            if (fences[i])
+                glDeleteSync(fences[i]);
+            fences[i] = 0;
+        }
+        if (ubo)
+        {
+            if (mapped)
+            {
+                glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+                glUnmapBuffer(GL_UNIFORM_BUFFER);
+                glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &ubo);
+        }
+        ubo = 0;
+        mapped = NULL;
+    }
+
+private:
+    GLuint ubo;
+    GLsizeiptr regionSize;
+    GLint alignment;
+    unsigned int frame;
+    GLsizeiptr head;
+    unsigned char* mapped;
+    bool persistent;
+    GLsync fences[FRAMES_IN_FLIGHT];
+
+    GLintptr regionOffset() const { return (GLintptr)frame * regionSize; }
+    GLsizeiptr alignUp(GLsizeiptr size) const { return (size + alignment - 1) / alignment * alignment; }
+};
+
+#endif
@@ -0,0 +1,992 @@
+#ifndef GL_CAPTURE_H
+#define GL_CAPTURE_H
+
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Nagrywanie strumienia poleceń OpenGL do kompaktowego pliku binarnego.
+// glcap::begin() podmienia wskaźniki funkcji GLAD (glad_glXxx) na wrappery,
+// które zapisują wywołanie razem z danymi (zawartość buforów, piksele tekstur,
+// źródła shaderów) i wołają oryginalną funkcję. Plik odtwarza program replay.cpp.
+//
+//   glcap::begin("hous.glcap");  // zaraz po gladLoadGLLoader, przed tworzeniem zasobów
+//   ... w pętli: glcap::frame(); przed glfwSwapBuffers ...
+//   glcap::end();
+//
+// Zapisy do zmapowanych buforów są nagrywane przy glFlushMappedBufferRange
+// (albo przy glUnmapBuffer, gdy mapowanie nie ma GL_MAP_FLUSH_EXPLICIT_BIT)
+// i odtwarzane jako glBufferSubData. Zapytania są nagrywane (odtwarzacz zamienia
+// GL_TIME_ELAPSED na pary GL_TIMESTAMP, bo sam mierzy klatki GL_TIME_ELAPSED),
+// ich wyniki i glGet* już nie.
+namespace glcap
+{
+    static const uint32_t MAGIC = 0x50414347; // "GCAP"
+    static const uint32_t VERSION = 1;
+
+    // nagłówek: MAGIC, VERSION, wersja GL (major, minor), rozmiar domyślnego framebuffera (w, h);
+    // dalej rekordy: u16 opcode, u32 długość danych, dane
+    enum Op
+    {
+        OP_FRAME_END = 1,
+
+        OP_GEN_BUFFERS, OP_DELETE_BUFFERS, OP_BIND_BUFFER, OP_BUFFER_DATA, OP_BUFFER_STORAGE,
+        OP_BUFFER_SUB_DATA, OP_BUFFER_WRITE, OP_BIND_BUFFER_RANGE, OP_BIND_BUFFER_BASE,
+
+        OP_GEN_VERTEX_ARRAYS, OP_DELETE_VERTEX_ARRAYS, OP_BIND_VERTEX_ARRAY,
+        OP_VERTEX_ATTRIB_POINTER, OP_VERTEX_ATTRIB_I_POINTER, OP_ENABLE_VERTEX_ATTRIB_ARRAY,
+        OP_DISABLE_VERTEX_ATTRIB_ARRAY, OP_VERTEX_ATTRIB_DIVISOR,
+
+        OP_CREATE_SHADER, OP_SHADER_SOURCE, OP_COMPILE_SHADER, OP_DELETE_SHADER,
+        OP_CREATE_PROGRAM, OP_ATTACH_SHADER, OP_LINK_PROGRAM, OP_USE_PROGRAM, OP_DELETE_PROGRAM,
+        OP_GET_UNIFORM_LOCATION, OP_GET_UNIFORM_BLOCK_INDEX, OP_UNIFORM_BLOCK_BINDING,
+        OP_UNIFORM_1I, OP_UNIFORM_1F, OP_UNIFORM_4F, OP_UNIFORM_MATRIX_4FV,
+
+        OP_GEN_TEXTURES, OP_DELETE_TEXTURES, OP_BIND_TEXTURE, OP_ACTIVE_TEXTURE,
+        OP_TEX_PARAMETER_I, OP_TEX_PARAMETER_F, OP_TEX_IMAGE_2D, OP_TEX_SUB_IMAGE_2D,
+        OP_GENERATE_MIPMAP, OP_PIXEL_STORE_I,
+
+        OP_GEN_FRAMEBUFFERS, OP_DELETE_FRAMEBUFFERS, OP_BIND_FRAMEBUFFER, OP_FRAMEBUFFER_TEXTURE_2D,
+        OP_GEN_RENDERBUFFERS, OP_DELETE_RENDERBUFFERS, OP_BIND_RENDERBUFFER, OP_RENDERBUFFER_STORAGE,
+        OP_FRAMEBUFFER_RENDERBUFFER, OP_BLIT_FRAMEBUFFER,
+
+        OP_VIEWPORT, OP_SCISSOR, OP_ENABLE, OP_DISABLE, OP_CLEAR_COLOR, OP_CLEAR, OP_POLYGON_MODE,
+        OP_DRAW_ARRAYS, OP_DRAW_ELEMENTS, OP_DRAW_ARRAYS_INSTANCED, OP_DRAW_ELEMENTS_INSTANCED,
+
+        OP_FENCE_SYNC, OP_CLIENT_WAIT_SYNC, OP_DELETE_SYNC,
+
+        // dopisane na końcu, żeby starsze nagrania dalej się odtwarzały
+        OP_UNIFORM_1UI, OP_UNIFORM_4FV, OP_TEX_BUFFER,
+        OP_DISPATCH_COMPUTE, OP_MEMORY_BARRIER, OP_CLEAR_BUFFER_DATA, OP_MULTI_DRAW_ARRAYS_INDIRECT,
+        OP_GEN_QUERIES, OP_DELETE_QUERIES, OP_BEGIN_QUERY, OP_END_QUERY, OP_QUERY_COUNTER,
+
+        OP_COUNT
+    };
+
+    // bajty na piksel dla formatów używanych przez dema
+    inline size_t pixelSize(GLenum format, GLenum type)
+    {
+        size_t components = 4;
+        switch (format)
+        {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: components = 1; break;
+        case GL_RG: case GL_RG_INTEGER: components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+        }
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+        case GL_UNSIGNED_INT_2_10_10_10_REV: case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_24_8: return 4;
+        default: return components * 4;
+        }
+    }
+
+    // rozmiar obrazu w pamięci klienta z uwzględnieniem GL_UNPACK_ALIGNMENT;
+    // ostatni wiersz nie jest dopełniany, GL czyta z niego tylko piksele
+    inline size_t imageSize(GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment)
+    {
+        if (width <= 0 || height <= 0)
+            return 0;
+        size_t pixels = (size_t)width * pixelSize(format, type);
+        size_t row = (pixels + alignment - 1) / alignment * alignment;
+        return (size_t)(height - 1) * row + pixels;
+    }
+
+    class Writer
+    {
+    public:
+        Writer() : file(NULL) {}
+
+        bool open(const char* path)
+        {
+            file = fopen(path, "wb");
+            if (file)
+                setvbuf(file, NULL, _IOFBF, 1 << 20);
+            return file != NULL;
+        }
+
+        void close()
+        {
+            if (file)
+                fclose(file);
+            file = NULL;
+        }
+
+        bool isOpen() const { return file != NULL; }
+
+        void begin(Op op) { record.clear(); opcode = (uint16_t)op; }
+        void u32(uint32_t v) { put(&v, 4); }
+        void i32(int32_t v) { put(&v, 4); }
+        void u64(uint64_t v) { put(&v, 8); }
+        void f32(float v) { put(&v, 4); }
+        void blob(const void* data, size_t size)
+        {
+            u32((uint32_t)(data ? size : 0));
+            if (data)
+                put(data, size);
+        }
+        void end()
+        {
+            uint32_t size = (uint32_t)record.size();
+            fwrite(&opcode, 2, 1, file);
+            fwrite(&size, 4, 1, file);
+            if (size)
+                fwrite(record.data(), 1, size, file);
+        }
+        void header(const uint32_t* words, int count) { fwrite(words, 4, count, file); }
+
+    private:
+        FILE* file;
+        uint16_t opcode;
+        std::vector<unsigned char> record;
+
+        void put(const void* data, size_t size)
+        {
+            const unsigned char* p = (const unsigned char*)data;
+            record.insert(record.end(), p, p + size);
+        }
+    };
+
+    struct State
+    {
+        Writer out;
+        GLint unpackAlignment;
+        std::map<GLenum, GLuint> boundBuffers;
+        struct Mapping { unsigned char* ptr; GLintptr offset; GLsizeiptr length; GLbitfield access; };
+        std::map<GLuint, Mapping> mappings;
+        std::map<GLsync, uint64_t> syncs;
+        uint64_t nextSync;
+
+        State() : unpackAlignment(4), nextSync(1) {}
+    };
+
+    inline State& state()
+    {
+        static State s;
+        return s;
+    }
+
+    inline Writer& out() { return state().out; }
+
+    inline void writeNames(Op op, GLsizei n, const GLuint* names)
+    {
+        out().begin(op);
+        out().i32(n);
+        for (GLsizei i = 0; i < n; i++)
+            out().u32(names[i]);
+        out().end();
+    }
+
+    // oryginalne wskaźniki GLAD
+    struct Real
+    {
+#define GLCAP_REAL(name) PFN##name##PROC name;
+        GLCAP_REAL(GLGENBUFFERS) GLCAP_REAL(GLDELETEBUFFERS) GLCAP_REAL(GLBINDBUFFER) GLCAP_REAL(GLBUFFERDATA)
+        GLCAP_REAL(GLBUFFERSUBDATA) GLCAP_REAL(GLMAPBUFFERRANGE) GLCAP_REAL(GLFLUSHMAPPEDBUFFERRANGE)
+        GLCAP_REAL(GLUNMAPBUFFER) GLCAP_REAL(GLBINDBUFFERRANGE) GLCAP_REAL(GLBINDBUFFERBASE)
+        GLCAP_REAL(GLGENVERTEXARRAYS) GLCAP_REAL(GLDELETEVERTEXARRAYS) GLCAP_REAL(GLBINDVERTEXARRAY)
+        GLCAP_REAL(GLVERTEXATTRIBPOINTER) GLCAP_REAL(GLVERTEXATTRIBIPOINTER) GLCAP_REAL(GLENABLEVERTEXATTRIBARRAY)
+        GLCAP_REAL(GLDISABLEVERTEXATTRIBARRAY) GLCAP_REAL(GLVERTEXATTRIBDIVISOR)
+        GLCAP_REAL(GLCREATESHADER) GLCAP_REAL(GLSHADERSOURCE) GLCAP_REAL(GLCOMPILESHADER) GLCAP_REAL(GLDELETESHADER)
+        GLCAP_REAL(GLCREATEPROGRAM) GLCAP_REAL(GLATTACHSHADER) GLCAP_REAL(GLLINKPROGRAM) GLCAP_REAL(GLUSEPROGRAM)
+        GLCAP_REAL(GLDELETEPROGRAM) GLCAP_REAL(GLGETUNIFORMLOCATION) GLCAP_REAL(GLGETUNIFORMBLOCKINDEX)
+        GLCAP_REAL(GLUNIFORMBLOCKBINDING) GLCAP_REAL(GLUNIFORM1I) GLCAP_REAL(GLUNIFORM1F) GLCAP_REAL(GLUNIFORM4F)
+        GLCAP_REAL(GLUNIFORMMATRIX4FV)
+        GLCAP_REAL(GLGENTEXTURES) GLCAP_REAL(GLDELETETEXTURES) GLCAP_REAL(GLBINDTEXTURE) GLCAP_REAL(GLACTIVETEXTURE)
+        GLCAP_REAL(GLTEXPARAMETERI) GLCAP_REAL(GLTEXPARAMETERF) GLCAP_REAL(GLTEXIMAGE2D) GLCAP_REAL(GLTEXSUBIMAGE2D)
+        GLCAP_REAL(GLGENERATEMIPMAP) GLCAP_REAL(GLPIXELSTOREI)
+        GLCAP_REAL(GLGENFRAMEBUFFERS) GLCAP_REAL(GLDELETEFRAMEBUFFERS) GLCAP_REAL(GLBINDFRAMEBUFFER)
+        GLCAP_REAL(GLFRAMEBUFFERTEXTURE2D) GLCAP_REAL(GLGENRENDERBUFFERS) GLCAP_REAL(GLDELETERENDERBUFFERS)
+        GLCAP_REAL(GLBINDRENDERBUFFER) GLCAP_REAL(GLRENDERBUFFERSTORAGE) GLCAP_REAL(GLFRAMEBUFFERRENDERBUFFER)
+        GLCAP_REAL(GLBLITFRAMEBUFFER)
+        GLCAP_REAL(GLVIEWPORT) GLCAP_REAL(GLSCISSOR) GLCAP_REAL(GLENABLE) GLCAP_REAL(GLDISABLE)
+        GLCAP_REAL(GLCLEARCOLOR) GLCAP_REAL(GLCLEAR) GLCAP_REAL(GLPOLYGONMODE)
+        GLCAP_REAL(GLDRAWARRAYS) GLCAP_REAL(GLDRAWELEMENTS) GLCAP_REAL(GLDRAWARRAYSINSTANCED)
+        GLCAP_REAL(GLDRAWELEMENTSINSTANCED)
+        GLCAP_REAL(GLFENCESYNC) GLCAP_REAL(GLCLIENTWAITSYNC) GLCAP_REAL(GLDELETESYNC)
+        GLCAP_REAL(GLUNIFORM1UI) GLCAP_REAL(GLUNIFORM4FV) GLCAP_REAL(GLTEXBUFFER)
+        GLCAP_REAL(GLGENQUERIES) GLCAP_REAL(GLDELETEQUERIES) GLCAP_REAL(GLBEGINQUERY) GLCAP_REAL(GLENDQUERY)
+        GLCAP_REAL(GLQUERYCOUNTER)
+#ifdef GL_COMPUTE_SHADER
+        GLCAP_REAL(GLDISPATCHCOMPUTE) GLCAP_REAL(GLMEMORYBARRIER) GLCAP_REAL(GLCLEARBUFFERDATA)
+        GLCAP_REAL(GLMULTIDRAWARRAYSINDIRECT)
+#endif
+#ifdef GL_MAP_PERSISTENT_BIT
+        GLCAP_REAL(GLBUFFERSTORAGE)
+#endif
+#undef GLCAP_REAL
+    };
+
+    inline Real& real()
+    {
+        static Real r;
+        return r;
+    }
+
+    // --- bufory -------------------------------------------------------------
+
+    inline void APIENTRY genBuffers(GLsizei n, GLuint* names)
+    {
+        real().GLGENBUFFERS(n, names);
+        writeNames(OP_GEN_BUFFERS, n, names);
+    }
+
+    inline void APIENTRY deleteBuffers(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_BUFFERS, n, names);
+        real().GLDELETEBUFFERS(n, names);
+    }
+
+    inline void APIENTRY bindBuffer(GLenum target, GLuint buffer)
+    {
+        state().boundBuffers[target] = buffer;
+        out().begin(OP_BIND_BUFFER); out().u32(target); out().u32(buffer); out().end();
+        real().GLBINDBUFFER(target, buffer);
+    }
+
+    inline void APIENTRY bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        out().begin(OP_BUFFER_DATA); out().u32(target); out().u64(size); out().u32(usage); out().blob(data, size); out().end();
+        real().GLBUFFERDATA(target, size, data, usage);
+    }
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    inline void APIENTRY bufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
+    {
+        out().begin(OP_BUFFER_STORAGE); out().u32(target); out().u64(size); out().u32(flags); out().blob(data, size); out().end();
+        real().GLBUFFERSTORAGE(target, size, data, flags);
+    }
+#endif
+
+    inline void APIENTRY bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        out().begin(OP_BUFFER_SUB_DATA); out().u32(target); out().u64(offset); out().blob(data, size); out().end();
+        real().GLBUFFERSUBDATA(target, offset, size, data);
+    }
+
+    inline void writeMapped(GLuint buffer, GLintptr offset, GLsizeiptr length)
+    {
+        State::Mapping& m = state().mappings[buffer];
+        out().begin(OP_BUFFER_WRITE); out().u32(buffer); out().u64(m.offset + offset); out().blob(m.ptr + offset, length); out().end();
+    }
+
+    inline void* APIENTRY mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+    {
+        void* ptr = real().GLMAPBUFFERRANGE(target, offset, length, access);
+        State::Mapping m = { (unsigned char*)ptr, offset, length, access };
+        state().mappings[state().boundBuffers[target]] = m;
+        return ptr;
+    }
+
+    inline void APIENTRY flushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+    {
+        writeMapped(state().boundBuffers[target], offset, length);
+        real().GLFLUSHMAPPEDBUFFERRANGE(target, offset, length);
+    }
+
+    inline GLboolean APIENTRY unmapBuffer(GLenum target)
+    {
+        GLuint buffer = state().boundBuffers[target];
+        State::Mapping& m = state().mappings[buffer];
+        if ((m.access & GL_MAP_WRITE_BIT) && !(m.access & GL_MAP_FLUSH_EXPLICIT_BIT) && m.ptr)
+            writeMapped(buffer, 0, m.length);
+        state().mappings.erase(buffer);
+        return real().GLUNMAPBUFFER(target);
+    }
+
+    inline void APIENTRY bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        out().begin(OP_BIND_BUFFER_RANGE); out().u32(target); out().u32(index); out().u32(buffer); out().u64(offset); out().u64(size); out().end();
+        real().GLBINDBUFFERRANGE(target, index, buffer, offset, size);
+    }
+
+    inline void APIENTRY bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        out().begin(OP_BIND_BUFFER_BASE); out().u32(target); out().u32(index); out().u32(buffer); out().end();
+        real().GLBINDBUFFERBASE(target, index, buffer);
+    }
+
+    // --- VAO ----------------------------------------------------------------
+
+    inline void APIENTRY genVertexArrays(GLsizei n, GLuint* names)
+    {
+        real().GLGENVERTEXARRAYS(n, names);
+        writeNames(OP_GEN_VERTEX_ARRAYS, n, names);
+    }
+
+    inline void APIENTRY deleteVertexArrays(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_VERTEX_ARRAYS, n, names);
+        real().GLDELETEVERTEXARRAYS(n, names);
+    }
+
+    inline void APIENTRY bindVertexArray(GLuint vao)
+    {
+        out().begin(OP_BIND_VERTEX_ARRAY); out().u32(vao); out().end();
+        real().GLBINDVERTEXARRAY(vao);
+    }
+
+    // w profilu core wskaźnik atrybutu jest zawsze przesunięciem w buforze
+    inline void APIENTRY vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+    {
+        out().begin(OP_VERTEX_ATTRIB_POINTER); out().u32(index); out().i32(size); out().u32(type); out().u32(normalized);
+        out().i32(stride); out().u64((uint64_t)(uintptr_t)pointer); out().end();
+        real().GLVERTEXATTRIBPOINTER(index, size, type, normalized, stride, pointer);
+    }
+
+    inline void APIENTRY vertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+    {
+        out().begin(OP_VERTEX_ATTRIB_I_POINTER); out().u32(index); out().i32(size); out().u32(type);
+        out().i32(stride); out().u64((uint64_t)(uintptr_t)pointer); out().end();
+        real().GLVERTEXATTRIBIPOINTER(index, size, type, stride, pointer);
+    }
+
+    inline void APIENTRY enableVertexAttribArray(GLuint index)
+    {
+        out().begin(OP_ENABLE_VERTEX_ATTRIB_ARRAY); out().u32(index); out().end();
+        real().GLENABLEVERTEXATTRIBARRAY(index);
+    }
+
+    inline void APIENTRY disableVertexAttribArray(GLuint index)
+    {
+        out().begin(OP_DISABLE_VERTEX_ATTRIB_ARRAY); out().u32(index); out().end();
+        real().GLDISABLEVERTEXATTRIBARRAY(index);
+    }
+
+    inline void APIENTRY vertexAttribDivisor(GLuint index, GLuint divisor)
+    {
+        out().begin(OP_VERTEX_ATTRIB_DIVISOR); out().u32(index); out().u32(divisor); out().end();
+        real().GLVERTEXATTRIBDIVISOR(index, divisor);
+    }
+
+    // --- shadery ------------------------------------------------------------
+
+    inline GLuint APIENTRY createShader(GLenum type)
+    {
+        GLuint shader = real().GLCREATESHADER(type);
+        out().begin(OP_CREATE_SHADER); out().u32(type); out().u32(shader); out().end();
+        return shader;
+    }
+
+    // wszystkie fragmenty źródła są sklejane w jeden napis
+    inline void APIENTRY shaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        std::string source;
+        for (GLsizei i = 0; i < count; i++)
+        {
+            if (lengths && lengths[i] >= 0)
+                source.append(strings[i], lengths[i]);
+            else
+                source.append(strings[i]);
+        }
+        out().begin(OP_SHADER_SOURCE); out().u32(shader); out().blob(source.data(), source.size()); out().end();
+        real().GLSHADERSOURCE(shader, count, strings, lengths);
+    }
+
+    inline void APIENTRY compileShader(GLuint shader)
+    {
+        out().begin(OP_COMPILE_SHADER); out().u32(shader); out().end();
+        real().GLCOMPILESHADER(shader);
+    }
+
+    inline void APIENTRY deleteShader(GLuint shader)
+    {
+        out().begin(OP_DELETE_SHADER); out().u32(shader); out().end();
+        real().GLDELETESHADER(shader);
+    }
+
+    inline GLuint APIENTRY createProgram()
+    {
+        GLuint program = real().GLCREATEPROGRAM();
+        out().begin(OP_CREATE_PROGRAM); out().u32(program); out().end();
+        return program;
+    }
+
+    inline void APIENTRY attachShader(GLuint program, GLuint shader)
+    {
+        out().begin(OP_ATTACH_SHADER); out().u32(program); out().u32(shader); out().end();
+        real().GLATTACHSHADER(program, shader);
+    }
+
+    inline void APIENTRY linkProgram(GLuint program)
+    {
+        out().begin(OP_LINK_PROGRAM); out().u32(program); out().end();
+        real().GLLINKPROGRAM(program);
+    }
+
+    inline void APIENTRY useProgram(GLuint program)
+    {
+        out().begin(OP_USE_PROGRAM); out().u32(program); out().end();
+        real().GLUSEPROGRAM(program);
+    }
+
+    inline void APIENTRY deleteProgram(GLuint program)
+    {
+        out().begin(OP_DELETE_PROGRAM); out().u32(program); out().end();
+        real().GLDELETEPROGRAM(program);
+    }
+
+    // nagrywany jest też wynik, żeby odtwarzacz mógł przemapować lokacje
+    inline GLint APIENTRY getUniformLocation(GLuint program, const GLchar* name)
+    {
+        GLint location = real().GLGETUNIFORMLOCATION(program, name);
+        out().begin(OP_GET_UNIFORM_LOCATION); out().u32(program); out().i32(location); out().blob(name, strlen(name) + 1); out().end();
+        return location;
+    }
+
+    inline GLuint APIENTRY getUniformBlockIndex(GLuint program, const GLchar* name)
+    {
+        GLuint index = real().GLGETUNIFORMBLOCKINDEX(program, name);
+        out().begin(OP_GET_UNIFORM_BLOCK_INDEX); out().u32(program); out().u32(index); out().blob(name, strlen(name) + 1); out().end();
+        return index;
+    }
+
+    inline void APIENTRY uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint binding)
+    {
+        out().begin(OP_UNIFORM_BLOCK_BINDING); out().u32(program); out().u32(blockIndex); out().u32(binding); out().end();
+        real().GLUNIFORMBLOCKBINDING(program, blockIndex, binding);
+    }
+
+    inline void APIENTRY uniform1i(GLint location, GLint v)
+    {
+        out().begin(OP_UNIFORM_1I); out().i32(location); out().i32(v); out().end();
+        real().GLUNIFORM1I(location, v);
+    }
+
+    inline void APIENTRY uniform1f(GLint location, GLfloat v)
+    {
+        out().begin(OP_UNIFORM_1F); out().i32(location); out().f32(v); out().end();
+        real().GLUNIFORM1F(location, v);
+    }
+
+    inline void APIENTRY uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+    {
+        out().begin(OP_UNIFORM_4F); out().i32(location); out().f32(x); out().f32(y); out().f32(z); out().f32(w); out().end();
+        real().GLUNIFORM4F(location, x, y, z, w);
+    }
+
+    inline void APIENTRY uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+    {
+        out().begin(OP_UNIFORM_MATRIX_4FV); out().i32(location); out().u32(transpose); out().blob(value, count * 16 * sizeof(GLfloat)); out().end();
+        real().GLUNIFORMMATRIX4FV(location, count, transpose, value);
+    }
+
+    inline void APIENTRY uniform1ui(GLint location, GLuint v)
+    {
+        out().begin(OP_UNIFORM_1UI); out().i32(location); out().u32(v); out().end();
+        real().GLUNIFORM1UI(location, v);
+    }
+
+    inline void APIENTRY uniform4fv(GLint location, GLsizei count, const GLfloat* value)
+    {
+        out().begin(OP_UNIFORM_4FV); out().i32(location); out().blob(value, count * 4 * sizeof(GLfloat)); out().end();
+        real().GLUNIFORM4FV(location, count, value);
+    }
+
+    // --- tekstury -----------------------------------------------------------
+
+    inline void APIENTRY genTextures(GLsizei n, GLuint* names)
+    {
+        real().GLGENTEXTURES(n, names);
+        writeNames(OP_GEN_TEXTURES, n, names);
+    }
+
+    inline void APIENTRY deleteTextures(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_TEXTURES, n, names);
+        real().GLDELETETEXTURES(n, names);
+    }
+
+    inline void APIENTRY bindTexture(GLenum target, GLuint texture)
+    {
+        out().begin(OP_BIND_TEXTURE); out().u32(target); out().u32(texture); out().end();
+        real().GLBINDTEXTURE(target, texture);
+    }
+
+    inline void APIENTRY activeTexture(GLenum unit)
+    {
+        out().begin(OP_ACTIVE_TEXTURE); out().u32(unit); out().end();
+        real().GLACTIVETEXTURE(unit);
+    }
+
+    inline void APIENTRY texParameteri(GLenum target, GLenum pname, GLint param)
+    {
+        out().begin(OP_TEX_PARAMETER_I); out().u32(target); out().u32(pname); out().i32(param); out().end();
+        real().GLTEXPARAMETERI(target, pname, param);
+    }
+
+    inline void APIENTRY texParameterf(GLenum target, GLenum pname, GLfloat param)
+    {
+        out().begin(OP_TEX_PARAMETER_F); out().u32(target); out().u32(pname); out().f32(param); out().end();
+        real().GLTEXPARAMETERF(target, pname, param);
+    }
+
+    // piksele z bufora GL_PIXEL_UNPACK_BUFFER nie są nagrywane (dema go nie używają)
+    inline const void* clientPixels(const void* pixels)
+    {
+        return state().boundBuffers[GL_PIXEL_UNPACK_BUFFER] ? NULL : pixels;
+    }
+
+    inline void APIENTRY texImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+        GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        out().begin(OP_TEX_IMAGE_2D); out().u32(target); out().i32(level); out().i32(internalformat);
+        out().i32(width); out().i32(height); out().u32(format); out().u32(type);
+        out().blob(clientPixels(pixels), imageSize(width, height, format, type, state().unpackAlignment)); out().end();
+        real().GLTEXIMAGE2D(target, level, internalformat, width, height, border, format, type, pixels);
+    }
+
+    inline void APIENTRY texSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+        GLenum format, GLenum type, const void* pixels)
+    {
+        out().begin(OP_TEX_SUB_IMAGE_2D); out().u32(target); out().i32(level); out().i32(x); out().i32(y);
+        out().i32(width); out().i32(height); out().u32(format); out().u32(type);
+        out().blob(clientPixels(pixels), imageSize(width, height, format, type, state().unpackAlignment)); out().end();
+        real().GLTEXSUBIMAGE2D(target, level, x, y, width, height, format, type, pixels);
+    }
+
+    inline void APIENTRY texBuffer(GLenum target, GLenum internalformat, GLuint buffer)
+    {
+        out().begin(OP_TEX_BUFFER); out().u32(target); out().u32(internalformat); out().u32(buffer); out().end();
+        real().GLTEXBUFFER(target, internalformat, buffer);
+    }
+
+    inline void APIENTRY generateMipmap(GLenum target)
+    {
+        out().begin(OP_GENERATE_MIPMAP); out().u32(target); out().end();
+        real().GLGENERATEMIPMAP(target);
+    }
+
+    inline void APIENTRY pixelStorei(GLenum pname, GLint param)
+    {
+        if (pname == GL_UNPACK_ALIGNMENT)
+            state().unpackAlignment = param;
+        out().begin(OP_PIXEL_STORE_I); out().u32(pname); out().i32(param); out().end();
+        real().GLPIXELSTOREI(pname, param);
+    }
+
+    // --- framebuffery -------------------------------------------------------
+
+    inline void APIENTRY genFramebuffers(GLsizei n, GLuint* names)
+    {
+        real().GLGENFRAMEBUFFERS(n, names);
+        writeNames(OP_GEN_FRAMEBUFFERS, n, names);
+    }
+
+    inline void APIENTRY deleteFramebuffers(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_FRAMEBUFFERS, n, names);
+        real().GLDELETEFRAMEBUFFERS(n, names);
+    }
+
+    inline void APIENTRY bindFramebuffer(GLenum target, GLuint framebuffer)
+    {
+        out().begin(OP_BIND_FRAMEBUFFER); out().u32(target); out().u32(framebuffer); out().end();
+        real().GLBINDFRAMEBUFFER(target, framebuffer);
+    }
+
+    inline void APIENTRY framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+    {
+        out().begin(OP_FRAMEBUFFER_TEXTURE_2D); out().u32(target); out().u32(attachment); out().u32(textarget);
+        out().u32(texture); out().i32(level); out().end();
+        real().GLFRAMEBUFFERTEXTURE2D(target, attachment, textarget, texture, level);
+    }
+
+    inline void APIENTRY genRenderbuffers(GLsizei n, GLuint* names)
+    {
+        real().GLGENRENDERBUFFERS(n, names);
+        writeNames(OP_GEN_RENDERBUFFERS, n, names);
+    }
+
+    inline void APIENTRY deleteRenderbuffers(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_RENDERBUFFERS, n, names);
+        real().GLDELETERENDERBUFFERS(n, names);
+    }
+
+    inline void APIENTRY bindRenderbuffer(GLenum target, GLuint renderbuffer)
+    {
+        out().begin(OP_BIND_RENDERBUFFER); out().u32(target); out().u32(renderbuffer); out().end();
+        real().GLBINDRENDERBUFFER(target, renderbuffer);
+    }
+
+    inline void APIENTRY renderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+    {
+        out().begin(OP_RENDERBUFFER_STORAGE); out().u32(target); out().u32(internalformat); out().i32(width); out().i32(height); out().end();
+        real().GLRENDERBUFFERSTORAGE(target, internalformat, width, height);
+    }
+
+    inline void APIENTRY framebufferRenderbuffer(GLenum target, GLenum attachment, GLenum rbTarget, GLuint renderbuffer)
+    {
+        out().begin(OP_FRAMEBUFFER_RENDERBUFFER); out().u32(target); out().u32(attachment); out().u32(rbTarget); out().u32(renderbuffer); out().end();
+        real().GLFRAMEBUFFERRENDERBUFFER(target, attachment, rbTarget, renderbuffer);
+    }
+
+    inline void APIENTRY blitFramebuffer(GLint sx0, GLint sy0, GLint sx1, GLint sy1, GLint dx0, GLint dy0, GLint dx1, GLint dy1,
+        GLbitfield mask, GLenum filter)
+    {
+        out().begin(OP_BLIT_FRAMEBUFFER);
+        out().i32(sx0); out().i32(sy0); out().i32(sx1); out().i32(sy1);
+        out().i32(dx0); out().i32(dy0); out().i32(dx1); out().i32(dy1);
+        out().u32(mask); out().u32(filter); out().end();
+        real().GLBLITFRAMEBUFFER(sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter);
+    }
+
+    // --- stan i rysowanie ---------------------------------------------------
+
+    inline void APIENTRY viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        out().begin(OP_VIEWPORT); out().i32(x); out().i32(y); out().i32(width); out().i32(height); out().end();
+        real().GLVIEWPORT(x, y, width, height);
+    }
+
+    inline void APIENTRY scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        out().begin(OP_SCISSOR); out().i32(x); out().i32(y); out().i32(width); out().i32(height); out().end();
+        real().GLSCISSOR(x, y, width, height);
+    }
+
+    inline void APIENTRY enable(GLenum cap)
+    {
+        out().begin(OP_ENABLE); out().u32(cap); out().end();
+        real().GLENABLE(cap);
+    }
+
+    inline void APIENTRY disable(GLenum cap)
+    {
+        out().begin(OP_DISABLE); out().u32(cap); out().end();
+        real().GLDISABLE(cap);
+    }
+
+    inline void APIENTRY clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+    {
+        out().begin(OP_CLEAR_COLOR); out().f32(r); out().f32(g); out().f32(b); out().f32(a); out().end();
+        real().GLCLEARCOLOR(r, g, b, a);
+    }
+
+    inline void APIENTRY clear(GLbitfield mask)
+    {
+        out().begin(OP_CLEAR); out().u32(mask); out().end();
+        real().GLCLEAR(mask);
+    }
+
+    inline void APIENTRY polygonMode(GLenum face, GLenum mode)
+    {
+        out().begin(OP_POLYGON_MODE); out().u32(face); out().u32(mode); out().end();
+        real().GLPOLYGONMODE(face, mode);
+    }
+
+    inline void APIENTRY drawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        out().begin(OP_DRAW_ARRAYS); out().u32(mode); out().i32(first); out().i32(count); out().end();
+        real().GLDRAWARRAYS(mode, first, count);
+    }
+
+    inline void APIENTRY drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+    {
+        out().begin(OP_DRAW_ELEMENTS); out().u32(mode); out().i32(count); out().u32(type); out().u64((uint64_t)(uintptr_t)indices); out().end();
+        real().GLDRAWELEMENTS(mode, count, type, indices);
+    }
+
+    inline void APIENTRY drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+    {
+        out().begin(OP_DRAW_ARRAYS_INSTANCED); out().u32(mode); out().i32(first); out().i32(count); out().i32(instances); out().end();
+        real().GLDRAWARRAYSINSTANCED(mode, first, count, instances);
+    }
+
+    inline void APIENTRY drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+    {
+        out().begin(OP_DRAW_ELEMENTS_INSTANCED); out().u32(mode); out().i32(count); out().u32(type);
+        out().u64((uint64_t)(uintptr_t)indices); out().i32(instances); out().end();
+        real().GLDRAWELEMENTSINSTANCED(mode, count, type, indices, instances);
+    }
+
+#ifdef GL_COMPUTE_SHADER
+    // --- compute i rysowanie pośrednie (GL 4.3) -----------------------------
+
+    inline void APIENTRY dispatchCompute(GLuint x, GLuint y, GLuint z)
+    {
+        out().begin(OP_DISPATCH_COMPUTE); out().u32(x); out().u32(y); out().u32(z); out().end();
+        real().GLDISPATCHCOMPUTE(x, y, z);
+    }
+
+    inline void APIENTRY memoryBarrier(GLbitfield barriers)
+    {
+        out().begin(OP_MEMORY_BARRIER); out().u32(barriers); out().end();
+        real().GLMEMORYBARRIER(barriers);
+    }
+
+    // dane to jeden piksel w formacie format/type albo NULL (zerowanie)
+    inline void APIENTRY clearBufferData(GLenum target, GLenum internalformat, GLenum format, GLenum type, const void* data)
+    {
+        out().begin(OP_CLEAR_BUFFER_DATA); out().u32(target); out().u32(internalformat); out().u32(format); out().u32(type);
+        out().blob(data, pixelSize(format, type)); out().end();
+        real().GLCLEARBUFFERDATA(target, internalformat, format, type, data);
+    }
+
+    // w profilu core polecenia są zawsze w GL_DRAW_INDIRECT_BUFFER, więc wskaźnik jest przesunięciem
+    inline void APIENTRY multiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride)
+    {
+        out().begin(OP_MULTI_DRAW_ARRAYS_INDIRECT); out().u32(mode); out().u64((uint64_t)(uintptr_t)indirect);
+        out().i32(drawcount); out().i32(stride); out().end();
+        real().GLMULTIDRAWARRAYSINDIRECT(mode, indirect, drawcount, stride);
+    }
+#endif
+
+    // --- zapytania ----------------------------------------------------------
+
+    inline void APIENTRY genQueries(GLsizei n, GLuint* names)
+    {
+        real().GLGENQUERIES(n, names);
+        writeNames(OP_GEN_QUERIES, n, names);
+    }
+
+    inline void APIENTRY deleteQueries(GLsizei n, const GLuint* names)
+    {
+        writeNames(OP_DELETE_QUERIES, n, names);
+        real().GLDELETEQUERIES(n, names);
+    }
+
+    inline void APIENTRY beginQuery(GLenum target, GLuint query)
+    {
+        out().begin(OP_BEGIN_QUERY); out().u32(target); out().u32(query); out().end();
+        real().GLBEGINQUERY(target, query);
+    }
+
+    inline void APIENTRY endQuery(GLenum target)
+    {
+        out().begin(OP_END_QUERY); out().u32(target); out().end();
+        real().GLENDQUERY(target);
+    }
+
+    inline void APIENTRY queryCounter(GLuint query, GLenum target)
+    {
+        out().begin(OP_QUERY_COUNTER); out().u32(query); out().u32(target); out().end();
+        real().GLQUERYCOUNTER(query, target);
+    }
+
+    // --- synchronizacja -----------------------------------------------------
+
+    inline GLsync APIENTRY fenceSync(GLenum condition, GLbitfield flags)
+    {
+        GLsync sync = real().GLFENCESYNC(condition, flags);
+        uint64_t id = state().nextSync++;
+        state().syncs[sync] = id;
+        out().begin(OP_FENCE_SYNC); out().u64(id); out().end();
+        return sync;
+    }
+
+    inline GLenum APIENTRY clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+    {
+        out().begin(OP_CLIENT_WAIT_SYNC); out().u64(state().syncs[sync]); out().u32(flags); out().u64(timeout); out().end();
+        return real().GLCLIENTWAITSYNC(sync, flags, timeout);
+    }
+
+    inline void APIENTRY deleteSync(GLsync sync)
+    {
+        out().begin(OP_DELETE_SYNC); out().u64(state().syncs[sync]); out().end();
+        state().syncs.erase(sync);
+        real().GLDELETESYNC(sync);
+    }
+
+    // --- sterowanie ---------------------------------------------------------
+
+    inline bool active() { return out().isOpen(); }
+
+    // podmiana wskaźników GLAD; wywołać zaraz po gladLoadGLLoader
+    inline bool begin(const char* path)
+    {
+        if (active())
+            return true;
+        if (!out().open(path))
+        {
+            printf("Nie udało się otworzyć pliku nagrania: %s\n", path);
+            return false;
+        }
+        GLint size[4] = { 0, 0, 0, 0 };
+        glGetIntegerv(GL_VIEWPORT, size);
+        uint32_t header[6] = { MAGIC, VERSION, (uint32_t)GLVersion.major, (uint32_t)GLVersion.minor,
+            (uint32_t)size[2], (uint32_t)size[3] };
+        out().header(header, 6);
+
+        Real& r = real();
+#define GLCAP_HOOK(glad, NAME, wrapper) r.NAME = glad; glad = wrapper;
+        GLCAP_HOOK(glad_glGenBuffers, GLGENBUFFERS, genBuffers)
+        GLCAP_HOOK(glad_glDeleteBuffers, GLDELETEBUFFERS, deleteBuffers)
+        GLCAP_HOOK(glad_glBindBuffer, GLBINDBUFFER, bindBuffer)
+        GLCAP_HOOK(glad_glBufferData, GLBUFFERDATA, bufferData)
+        GLCAP_HOOK(glad_glBufferSubData, GLBUFFERSUBDATA, bufferSubData)
+        GLCAP_HOOK(glad_glMapBufferRange, GLMAPBUFFERRANGE, mapBufferRange)
+        GLCAP_HOOK(glad_glFlushMappedBufferRange, GLFLUSHMAPPEDBUFFERRANGE, flushMappedBufferRange)
+        GLCAP_HOOK(glad_glUnmapBuffer, GLUNMAPBUFFER, unmapBuffer)
+        GLCAP_HOOK(glad_glBindBufferRange, GLBINDBUFFERRANGE, bindBufferRange)
+        GLCAP_HOOK(glad_glBindBufferBase, GLBINDBUFFERBASE, bindBufferBase)
+        GLCAP_HOOK(glad_glGenVertexArrays, GLGENVERTEXARRAYS, genVertexArrays)
+        GLCAP_HOOK(glad_glDeleteVertexArrays, GLDELETEVERTEXARRAYS, deleteVertexArrays)
+        GLCAP_HOOK(glad_glBindVertexArray, GLBINDVERTEXARRAY, bindVertexArray)
+        GLCAP_HOOK(glad_glVertexAttribPointer, GLVERTEXATTRIBPOINTER, vertexAttribPointer)
+        GLCAP_HOOK(glad_glVertexAttribIPointer, GLVERTEXATTRIBIPOINTER, vertexAttribIPointer)
+        GLCAP_HOOK(glad_glEnableVertexAttribArray, GLENABLEVERTEXATTRIBARRAY, enableVertexAttribArray)
+        GLCAP_HOOK(glad_glDisableVertexAttribArray, GLDISABLEVERTEXATTRIBARRAY, disableVertexAttribArray)
+        GLCAP_HOOK(glad_glVertexAttribDivisor, GLVERTEXATTRIBDIVISOR, vertexAttribDivisor)
+        GLCAP_HOOK(glad_glCreateShader, GLCREATESHADER, createShader)
+        GLCAP_HOOK(glad_glShaderSource, GLSHADERSOURCE, shaderSource)
+        GLCAP_HOOK(glad_glCompileShader, GLCOMPILESHADER, compileShader)
+        GLCAP_HOOK(glad_glDeleteShader, GLDELETESHADER, deleteShader)
+        GLCAP_HOOK(glad_glCreateProgram, GLCREATEPROGRAM, createProgram)
+        GLCAP_HOOK(glad_glAttachShader, GLATTACHSHADER, attachShader)
+        GLCAP_HOOK(glad_glLinkProgram, GLLINKPROGRAM, linkProgram)
+        GLCAP_HOOK(glad_glUseProgram, GLUSEPROGRAM, useProgram)
+        GLCAP_HOOK(glad_glDeleteProgram, GLDELETEPROGRAM, deleteProgram)
+        GLCAP_HOOK(glad_glGetUniformLocation, GLGETUNIFORMLOCATION, getUniformLocation)
+        GLCAP_HOOK(glad_glGetUniformBlockIndex, GLGETUNIFORMBLOCKINDEX, getUniformBlockIndex)
+        GLCAP_HOOK(glad_glUniformBlockBinding, GLUNIFORMBLOCKBINDING, uniformBlockBinding)
+        GLCAP_HOOK(glad_glUniform1i, GLUNIFORM1I, uniform1i)
+        GLCAP_HOOK(glad_glUniform1f, GLUNIFORM1F, uniform1f)
+        GLCAP_HOOK(glad_glUniform4f, GLUNIFORM4F, uniform4f)
+        GLCAP_HOOK(glad_glUniformMatrix4fv, GLUNIFORMMATRIX4FV, uniformMatrix4fv)
+        GLCAP_HOOK(glad_glGenTextures, GLGENTEXTURES, genTextures)
+        GLCAP_HOOK(glad_glDeleteTextures, GLDELETETEXTURES, deleteTextures)
+        GLCAP_HOOK(glad_glBindTexture, GLBINDTEXTURE, bindTexture)
+        GLCAP_HOOK(glad_glActiveTexture, GLACTIVETEXTURE, activeTexture)
+        GLCAP_HOOK(glad_glTexParameteri, GLTEXPARAMETERI, texParameteri)
+        GLCAP_HOOK(glad_glTexParameterf, GLTEXPARAMETERF, texParameterf)
+        GLCAP_HOOK(glad_glTexImage2D, GLTEXIMAGE2D, texImage2D)
+        GLCAP_HOOK(glad_glTexSubImage2D, GLTEXSUBIMAGE2D, texSubImage2D)
+        GLCAP_HOOK(glad_glGenerateMipmap, GLGENERATEMIPMAP, generateMipmap)
+        GLCAP_HOOK(glad_glPixelStorei, GLPIXELSTOREI, pixelStorei)
+        GLCAP_HOOK(glad_glGenFramebuffers, GLGENFRAMEBUFFERS, genFramebuffers)
+        GLCAP_HOOK(glad_glDeleteFramebuffers, GLDELETEFRAMEBUFFERS, deleteFramebuffers)
+        GLCAP_HOOK(glad_glBindFramebuffer, GLBINDFRAMEBUFFER, bindFramebuffer)
+        GLCAP_HOOK(glad_glFramebufferTexture2D, GLFRAMEBUFFERTEXTURE2D, framebufferTexture2D)
+        GLCAP_HOOK(glad_glGenRenderbuffers, GLGENRENDERBUFFERS, genRenderbuffers)
+        GLCAP_HOOK(glad_glDeleteRenderbuffers, GLDELETERENDERBUFFERS, deleteRenderbuffers)
+        GLCAP_HOOK(glad_glBindRenderbuffer, GLBINDRENDERBUFFER, bindRenderbuffer)
+        GLCAP_HOOK(glad_glRenderbufferStorage, GLRENDERBUFFERSTORAGE, renderbufferStorage)
+        GLCAP_HOOK(glad_glFramebufferRenderbuffer, GLFRAMEBUFFERRENDERBUFFER, framebufferRenderbuffer)
+        GLCAP_HOOK(glad_glBlitFramebuffer, GLBLITFRAMEBUFFER, blitFramebuffer)
+        GLCAP_HOOK(glad_glViewport, GLVIEWPORT, viewport)
+        GLCAP_HOOK(glad_glScissor, GLSCISSOR, scissor)
+        GLCAP_HOOK(glad_glEnable, GLENABLE, enable)
+        GLCAP_HOOK(glad_glDisable, GLDISABLE, disable)
+        GLCAP_HOOK(glad_glClearColor, GLCLEARCOLOR, clearColor)
+        GLCAP_HOOK(glad_glClear, GLCLEAR, clear)
+        GLCAP_HOOK(glad_glPolygonMode, GLPOLYGONMODE, polygonMode)
+        GLCAP_HOOK(glad_glDrawArrays, GLDRAWARRAYS, drawArrays)
+        GLCAP_HOOK(glad_glDrawElements, GLDRAWELEMENTS, drawElements)
+        GLCAP_HOOK(glad_glDrawArraysInstanced, GLDRAWARRAYSINSTANCED, drawArraysInstanced)
+        GLCAP_HOOK(glad_glDrawElementsInstanced, GLDRAWELEMENTSINSTANCED, drawElementsInstanced)
+        GLCAP_HOOK(glad_glFenceSync, GLFENCESYNC, fenceSync)
+        GLCAP_HOOK(glad_glClientWaitSync, GLCLIENTWAITSYNC, clientWaitSync)
+        GLCAP_HOOK(glad_glDeleteSync, GLDELETESYNC, deleteSync)
+        GLCAP_HOOK(glad_glUniform1ui, GLUNIFORM1UI, uniform1ui)
+        GLCAP_HOOK(glad_glUniform4fv, GLUNIFORM4FV, uniform4fv)
+        GLCAP_HOOK(glad_glTexBuffer, GLTEXBUFFER, texBuffer)
+        GLCAP_HOOK(glad_glGenQueries, GLGENQUERIES, genQueries)
+        GLCAP_HOOK(glad_glDeleteQueries, GLDELETEQUERIES, deleteQueries)
+        GLCAP_HOOK(glad_glBeginQuery, GLBEGINQUERY, beginQuery)
+        GLCAP_HOOK(glad_glEndQuery, GLENDQUERY, endQuery)
+        GLCAP_HOOK(glad_glQueryCounter, GLQUERYCOUNTER, queryCounter)
+#ifdef GL_COMPUTE_SHADER
+        if (glad_glDispatchCompute)
+        {
+            GLCAP_HOOK(glad_glDispatchCompute, GLDISPATCHCOMPUTE, dispatchCompute)
+            GLCAP_HOOK(glad_glMemoryBarrier, GLMEMORYBARRIER, memoryBarrier)
+            GLCAP_HOOK(glad_glClearBufferData, GLCLEARBUFFERDATA, clearBufferData)
+            GLCAP_HOOK(glad_glMultiDrawArraysIndirect, GLMULTIDRAWARRAYSINDIRECT, multiDrawArraysIndirect)
+        }
+#endif
+#ifdef GL_MAP_PERSISTENT_BIT
+        if (glad_glBufferStorage)
+        {
+            GLCAP_HOOK(glad_glBufferStorage, GLBUFFERSTORAGE, bufferStorage)
+        }
+#endif
+#undef GLCAP_HOOK
+        return true;
+    }
+
+    // znacznik końca klatki; wywołać przed glfwSwapBuffers
+    inline void frame()
+    {
+        if (!active())
+            return;
+        out().begin(OP_FRAME_END);
+        out().end();
+    }
+
+    // przywrócenie oryginalnych wskaźników i zamknięcie pliku
+    inline void end()
+    {
+        if (!active())
+            return;
+        Real& r = real();
+#define GLCAP_UNHOOK(glad, NAME) glad = r.NAME;
+        GLCAP_UNHOOK(glad_glGenBuffers, GLGENBUFFERS) GLCAP_UNHOOK(glad_glDeleteBuffers, GLDELETEBUFFERS)
+        GLCAP_UNHOOK(glad_glBindBuffer, GLBINDBUFFER) GLCAP_UNHOOK(glad_glBufferData, GLBUFFERDATA)
+        GLCAP_UNHOOK(glad_glBufferSubData, GLBUFFERSUBDATA) GLCAP_UNHOOK(glad_glMapBufferRange, GLMAPBUFFERRANGE)
+        GLCAP_UNHOOK(glad_glFlushMappedBufferRange, GLFLUSHMAPPEDBUFFERRANGE) GLCAP_UNHOOK(glad_glUnmapBuffer, GLUNMAPBUFFER)
+        GLCAP_UNHOOK(glad_glBindBufferRange, GLBINDBUFFERRANGE) GLCAP_UNHOOK(glad_glBindBufferBase, GLBINDBUFFERBASE)
+        GLCAP_UNHOOK(glad_glGenVertexArrays, GLGENVERTEXARRAYS) GLCAP_UNHOOK(glad_glDeleteVertexArrays, GLDELETEVERTEXARRAYS)
+        GLCAP_UNHOOK(glad_glBindVertexArray, GLBINDVERTEXARRAY) GLCAP_UNHOOK(glad_glVertexAttribPointer, GLVERTEXATTRIBPOINTER)
+        GLCAP_UNHOOK(glad_glVertexAttribIPointer, GLVERTEXATTRIBIPOINTER)
+        GLCAP_UNHOOK(glad_glEnableVertexAttribArray, GLENABLEVERTEXATTRIBARRAY)
+        GLCAP_UNHOOK(glad_glDisableVertexAttribArray, GLDISABLEVERTEXATTRIBARRAY)
+        GLCAP_UNHOOK(glad_glVertexAttribDivisor, GLVERTEXATTRIBDIVISOR)
+        GLCAP_UNHOOK(glad_glCreateShader, GLCREATESHADER) GLCAP_UNHOOK(glad_glShaderSource, GLSHADERSOURCE)
+        GLCAP_UNHOOK(glad_glCompileShader, GLCOMPILESHADER) GLCAP_UNHOOK(glad_glDeleteShader, GLDELETESHADER)
+        GLCAP_UNHOOK(glad_glCreateProgram, GLCREATEPROGRAM) GLCAP_UNHOOK(glad_glAttachShader, GLATTACHSHADER)
+        GLCAP_UNHOOK(glad_glLinkProgram, GLLINKPROGRAM) GLCAP_UNHOOK(glad_glUseProgram, GLUSEPROGRAM)
+        GLCAP_UNHOOK(glad_glDeleteProgram, GLDELETEPROGRAM) GLCAP_UNHOOK(glad_glGetUniformLocation, GLGETUNIFORMLOCATION)
+        GLCAP_UNHOOK(glad_glGetUniformBlockIndex, GLGETUNIFORMBLOCKINDEX)
+        GLCAP_UNHOOK(glad_glUniformBlockBinding, GLUNIFORMBLOCKBINDING)
+        GLCAP_UNHOOK(glad_glUniform1i, GLUNIFORM1I) GLCAP_UNHOOK(glad_glUniform1f, GLUNIFORM1F)
+        GLCAP_UNHOOK(glad_glUniform4f, GLUNIFORM4F) GLCAP_UNHOOK(glad_glUniformMatrix4fv, GLUNIFORMMATRIX4FV)
+        GLCAP_UNHOOK(glad_glGenTextures, GLGENTEXTURES) GLCAP_UNHOOK(glad_glDeleteTextures, GLDELETETEXTURES)
+        GLCAP_UNHOOK(glad_glBindTexture, GLBINDTEXTURE) GLCAP_UNHOOK(glad_glActiveTexture, GLACTIVETEXTURE)
+        GLCAP_UNHOOK(glad_glTexParameteri, GLTEXPARAMETERI) GLCAP_UNHOOK(glad_glTexParameterf, GLTEXPARAMETERF)
+        GLCAP_UNHOOK(glad_glTexImage2D, GLTEXIMAGE2D) GLCAP_UNHOOK(glad_glTexSubImage2D, GLTEXSUBIMAGE2D)
+        GLCAP_UNHOOK(glad_glGenerateMipmap, GLGENERATEMIPMAP) GLCAP_UNHOOK(glad_glPixelStorei, GLPIXELSTOREI)
+        GLCAP_UNHOOK(glad_glGenFramebuffers, GLGENFRAMEBUFFERS) GLCAP_UNHOOK(glad_glDeleteFramebuffers, GLDELETEFRAMEBUFFERS)
+        GLCAP_UNHOOK(glad_glBindFramebuffer, GLBINDFRAMEBUFFER) GLCAP_UNHOOK(glad_glFramebufferTexture2D, GLFRAMEBUFFERTEXTURE2D)
+        GLCAP_UNHOOK(glad_glGenRenderbuffers, GLGENRENDERBUFFERS) GLCAP_UNHOOK(glad_glDeleteRenderbuffers, GLDELETERENDERBUFFERS)
+        GLCAP_UNHOOK(glad_glBindRenderbuffer, GLBINDRENDERBUFFER) GLCAP_UNHOOK(glad_glRenderbufferStorage, GLRENDERBUFFERSTORAGE)
+        GLCAP_UNHOOK(glad_glFramebufferRenderbuffer, GLFRAMEBUFFERRENDERBUFFER)
+        GLCAP_UNHOOK(glad_glBlitFramebuffer, GLBLITFRAMEBUFFER)
+        GLCAP_UNHOOK(glad_glViewport, GLVIEWPORT) GLCAP_UNHOOK(glad_glScissor, GLSCISSOR)
+        GLCAP_UNHOOK(glad_glEnable, GLENABLE) GLCAP_UNHOOK(glad_glDisable, GLDISABLE)
+        GLCAP_UNHOOK(glad_glClearColor, GLCLEARCOLOR) GLCAP_UNHOOK(glad_glClear, GLCLEAR)
+        GLCAP_UNHOOK(glad_glPolygonMode, GLPOLYGONMODE) GLCAP_UNHOOK(glad_glDrawArrays, GLDRAWARRAYS)
+        GLCAP_UNHOOK(glad_glDrawElements, GLDRAWELEMENTS) GLCAP_UNHOOK(glad_glDrawArraysInstanced, GLDRAWARRAYSINSTANCED)
+        GLCAP_UNHOOK(glad_glDrawElementsInstanced, GLDRAWELEMENTSINSTANCED)
+        GLCAP_UNHOOK(glad_glFenceSync, GLFENCESYNC) GLCAP_UNHOOK(glad_glClientWaitSync, GLCLIENTWAITSYNC)
+        GLCAP_UNHOOK(glad_glDeleteSync, GLDELETESYNC)
+        GLCAP_UNHOOK(glad_glUniform1ui, GLUNIFORM1UI) GLCAP_UNHOOK(glad_glUniform4fv, GLUNIFORM4FV)
+        GLCAP_UNHOOK(glad_glTexBuffer, GLTEXBUFFER)
+        GLCAP_UNHOOK(glad_glGenQueries, GLGENQUERIES) GLCAP_UNHOOK(glad_glDeleteQueries, GLDELETEQUERIES)
+        GLCAP_UNHOOK(glad_glBeginQuery, GLBEGINQUERY) GLCAP_UNHOOK(glad_glEndQuery, GLENDQUERY)
+        GLCAP_UNHOOK(glad_glQueryCounter, GLQUERYCOUNTER)
+#ifdef GL_COMPUTE_SHADER
+        if (r.GLDISPATCHCOMPUTE)
+        {
+            GLCAP_UNHOOK(glad_glDispatchCompute, GLDISPATCHCOMPUTE) GLCAP_UNHOOK(glad_glMemoryBarrier, GLMEMORYBARRIER)
+            GLCAP_UNHOOK(glad_glClearBufferData, GLCLEARBUFFERDATA)
+            GLCAP_UNHOOK(glad_glMultiDrawArraysIndirect, GLMULTIDRAWARRAYSINDIRECT)
+        }
+#endif
+#ifdef GL_MAP_PERSISTENT_BIT
+        if (r.GLBUFFERSTORAGE)
+            GLCAP_UNHOOK(glad_glBufferStorage, GLBUFFERSTORAGE)
+#endif
+#undef GLCAP_UNHOOK
+        out().close();
+    }
+}
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef GPU_CULLING_H
+#define GPU_CULLING_H
+
+#include <glad/glad.h>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Rysowanie sterowane przez GPU (GL 4.3+): opisy wszystkich obiektów leżą w buforze
+// SSBO, shader obliczeniowy odrzuca te poza bryłą widzenia i zapisuje zwarte polecenia
+// glMultiDrawArraysIndirect, a CPU wysyła jedno wywołanie na segment (materiał),
+// niezależnie od liczby obiektów.
+//
+// Polecenia segmentu zajmują stałe miejsce w buforze poleceń (pojemność = liczba
+// obiektów z tym materiałem). Widoczne obiekty są dopisywane od początku segmentu
+// (licznik atomowy), a reszta jest zerowana przed odrzucaniem, więc niewykorzystane
+// polecenia niczego nie rysują.
+//
+// Indeks obiektu trafia do shadera wierzchołków przez baseInstance polecenia i atrybut
+// z dzielnikiem 1 (lokalizacja OBJECT_INDEX_LOCATION), bo gl_BaseInstance wymaga 4.6.
+// Macierz model shader czyta z tego samego bufora obiektów, ale jako bufor tekstury
+// (jednostka OBJECT_TEXTURE_UNIT): 4.3 nie gwarantuje SSBO w shaderze wierzchołków.
+//
+// Bez GL_COMPUTE_SHADER w nagłówkach albo na kontekście starszym niż 4.3 available()
+// zwraca false i trzeba użyć zwykłej ścieżki CPU.
+
+class GpuCulling
+{
+public:
+    // układ std430, zgodny ze strukturą Object w shaderach
+    struct Object
+    {
+        float model[16];
+        float sphere[4];   // środek (w układzie obiektu) i promień
+        uint32_t first, count;
+        uint32_t segment;
+        uint32_t pad;
+    };
+
+    static const GLuint OBJECT_INDEX_LOCATION = 2;
+    static const GLuint OBJECT_TEXTURE_UNIT = 1;
+
+    // shader wierzchołków ścieżki GPU: pozycja i uv jak w CompactTexturedVertex
+    static const char* vertexShaderSource()
+    {
+        return "#version 430 core\n"
+            "layout (location = 0) in vec3 aPos;\n"
+            "layout (location = 1) in vec2 aTexCoord;\n"
+            "layout (location = 2) in uint aObject;\n"
+            "uniform samplerBuffer objectData;\n" // Object = 6 x vec4, model w pierwszych czterech
+            "out vec2 TexCoord;\n"
+            "void main()\n"
+            "{\n"
+            "   int base = int(aObject) * 6;\n"
+            "   mat4 model = mat4(texelFetch(objectData, base), texelFetch(objectData, base + 1),\n"
+            "                     texelFetch(objectData, base + 2), texelFetch(objectData, base + 3));\n"
+            "   gl_Position = model * vec4(aPos, 1.0);\n"
+            "   TexCoord = aTexCoord;\n"
+            "}\0";
+    }
+
+    GpuCulling() : program(0), objects(0), segments(0), commands(0), objectIndices(0), objectTexture(0),
+        objectCountLocation(-1), planesLocation(-1), objectCapacity(0), objectCount(0)
+    {
+        const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        setViewProjection(identity);
+    }
+
+    static bool available()
+    {
+#ifdef GL_COMPUTE_SHADER
+        return GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+#else
+        return false;
+#endif
+    }
+
+    // segmentSizes[i] = ile obiektów może mieć segment i
+    bool init(const std::vector<uint32_t>& segmentSizes)
+    {
+#ifdef GL_COMPUTE_SHADER
+        if (!available())
+            return false;
+        program = compileCompute(cullShaderSource());
+        if (program == 0)
+            return false;
+
+        objectCapacity = 0;
+        for (size_t i = 0; i < segmentSizes.size(); i++)
+        {
+            Segment s = { objectCapacity, 0 };
+            segmentTable.push_back(s);
+            objectCapacity += segmentSizes[i];
+        }
+        segmentCapacity = segmentSizes;
+
+        glGenBuffers(1, &objects);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, objects);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, objectCapacity * sizeof(Object), NULL, GL_STATIC_DRAW);
+        glGenBuffers(1, &segments);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, segments);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, segmentTable.size() * sizeof(Segment), NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glGenTextures(1, &objectTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, objects);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+        glGenBuffers(1, &commands);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, objectCapacity * sizeof(Command), NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        // indeksy 0..N-1 czytane z dzielnikiem 1: z baseInstance = i atrybut ma wartość i
+        std::vector<uint32_t> indices(objectCapacity);
+        for (uint32_t i = 0; i < objectCapacity; i++)
+            indices[i] = i;
+        glGenBuffers(1, &objectIndices);
+        glBindBuffer(GL_ARRAY_BUFFER, objectIndices);
+        glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.empty() ? NULL : &indices[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        objectCountLocation = glGetUniformLocation(program, "objectCount");
+        planesLocation = glGetUniformLocation(program, "planes");
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // przygotowanie programu zbudowanego z vertexShaderSource()
+    void setupProgram(GLuint drawProgram)
+    {
+        glUseProgram(drawProgram);
+        glUniform1i(glGetUniformLocation(drawProgram, "objectData"), OBJECT_TEXTURE_UNIT);
+    }
+
+    // dodanie do aktualnie powiązanego VAO atrybutu z indeksem obiektu
+    void setupObjectIndex()
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, objectIndices);
+        glVertexAttribIPointer(OBJECT_INDEX_LOCATION, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+        glVertexAttribDivisor(OBJECT_INDEX_LOCATION, 1);
+        glEnableVertexAttribArray(OBJECT_INDEX_LOCATION);
+    }
+
+    // zapis opisów obiektów first..first+count-1; obiekty o indeksach < objectCount są odrzucane i rysowane
+    void setObjects(uint32_t first, const Object* data, uint32_t count)
+    {
+#ifdef GL_COMPUTE_SHADER
+        if (count == 0 || first + count > objectCapacity)
+            return;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, objects);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, first * sizeof(Object), count * sizeof(Object), data);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+#endif
+    }
+
+    void setObjectCount(uint32_t count) { objectCount = count < objectCapacity ? count : objectCapacity; }
+
+    // płaszczyzny bryły widzenia z macierzy projekcja * widok (kolumnami, jak w GL)
+    void setViewProjection(const float* m)
+    {
+        for (int p = 0; p < 6; p++)
+        {
+            int row = p / 2;
+            float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+            float* plane = planes + p * 4;
+            for (int c = 0; c < 4; c++)
+                plane[c] = m[c * 4 + 3] + sign * m[c * 4 + row];
+            float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f)
+                for (int c = 0; c < 4; c++)
+                    plane[c] /= length;
+        }
+    }
+
+    // odrzucanie i zapis poleceń; koszt CPU nie zależy od liczby obiektów
+    void cull()
+    {
+#ifdef GL_COMPUTE_SHADER
+        if (program == 0 || segmentTable.empty())
+            return;
+        GLuint zero = 0;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+        glClearBufferData(GL_DRAW_INDIRECT_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, segments);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, segmentTable.size() * sizeof(Segment), &segmentTable[0]);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        glUseProgram(program);
+        glUniform1ui(objectCountLocation, objectCount);
+        glUniform4fv(planesLocation, 6, planes);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, objects);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, segments);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commands);
+        glDispatchCompute((objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+        glActiveTexture(GL_TEXTURE0 + OBJECT_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+        glActiveTexture(GL_TEXTURE0);
+#endif
+    }
+
+    // jedno wywołanie na cały segment, po cull(); przed nim program, tekstury i VAO z setupObjectIndex()
+    void draw(uint32_t segment)
+    {
+#ifdef GL_COMPUTE_SHADER
+        if (program == 0 || segment >= segmentTable.size() || segmentCapacity[segment] == 0)
+            return;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+        glMultiDrawArraysIndirect(GL_TRIANGLES, (void*)(segmentTable[segment].base * sizeof(Command)),
+            segmentCapacity[segment], 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#endif
+    }
+
+    size_t sizeBytes() const
+    {
+        return objectCapacity * (sizeof(Object) + sizeof(Command) + sizeof(uint32_t))
+            + segmentTable.size() * sizeof(Segment);
+    }
+
+    void destroy()
+    {
+        if (program)
+            glDeleteProgram(program);
+        if (objectTexture)
+            glDeleteTextures(1, &objectTexture);
+        GLuint buffers[4] = { objects, segments, commands, objectIndices };
+        glDeleteBuffers(4, buffers);
+        program = objects = segments = commands = objectIndices = objectTexture = 0;
+        segmentTable.clear();
+        segmentCapacity.clear();
+        objectCapacity = objectCount = 0;
+    }
+
+private:
+    static const uint32_t WORKGROUP_SIZE = 64;
+
+    struct Segment { uint32_t base, count; };
+    struct Command { uint32_t count, instanceCount, first, baseInstance; };
+
+    GLuint program;
+    GLuint objects, segments, commands, objectIndices;
+    GLuint objectTexture; // widok bufora obiektów dla shadera wierzchołków
+    GLint objectCountLocation, planesLocation;
+    std::vector<Segment> segmentTable;
+    std::vector<uint32_t> segmentCapacity;
+    uint32_t objectCapacity, objectCount;
+    float planes[24];
+
+    static const char* cullShaderSource()
+    {
+        return "#version 430 core\n"
+            "layout (local_size_x = 64) in;\n"
+            "struct Object { mat4 model; vec4 sphere; uint first; uint count; uint segment; uint pad; };\n"
+            "struct Segment { uint base; uint count; };\n"
+            "struct Command { uint count; uint instanceCount; uint first; uint baseInstance; };\n"
+            "layout (std430, binding = 0) readonly buffer Objects { Object objects[]; };\n"
+            "layout (std430, binding = 1) buffer Segments { Segment segments[]; };\n"
+            "layout (std430, binding = 2) writeonly buffer Commands { Command commands[]; };\n"
+            "uniform uint objectCount;\n"
+            "uniform vec4 planes[6];\n"
+            "void main()\n"
+            "{\n"
+            "   uint i = gl_GlobalInvocationID.x;\n"
+            "   if (i >= objectCount)\n"
+            "       return;\n"
+            "   Object o = objects[i];\n"
+            "   vec3 center = (o.model * vec4(o.sphere.xyz, 1.0)).xyz;\n"
+            "   float scale = max(length(o.model[0].xyz), max(length(o.model[1].xyz), length(o.model[2].xyz)));\n"
+            "   float radius = o.sphere.w * scale;\n"
+            "   for (int p = 0; p < 6; p++)\n"
+            "       if (dot(planes[p].xyz, center) + planes[p].w < -radius)\n"
+            "           return;\n"
+            "   uint slot = segments[o.segment].base + atomicAdd(segments[o.segment].count, 1u);\n"
+            "   commands[slot] = Command(o.count, 1u, o.first, i);\n"
+            "}\0";
+    }
+
+#ifdef GL_COMPUTE_SHADER
+    static GLuint compileCompute(const char* source)
+    {
+        int success;
+        char infoLog[512];
+        GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(shader, 1, &source, NULL);
+        glCompileShader(shader);
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(shader, 512, NULL, infoLog);
+            std::cout << "BŁĄD::SHADER::COMPUTE::KOMPILACJA_NIEUDANA\n" << infoLog << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        GLuint program = glCreateProgram();
+        glAttachShader(program, shader);
+        glLinkProgram(program);
+        glDeleteShader(shader);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            glGetProgramInfoLog(program, 512, NULL, infoLog);
+            std::cout << "BŁĄD::SHADER::PROGRAM::LINKING_NIEUDANY\n" << infoLog << std::endl;
+            glDeleteProgram(program);
+            return 0;
+        }
+        return program;
+    }
+#endif
+};
+
+#endif
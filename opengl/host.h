@@ -0,0 +1,335 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <stb_image.h>
+#include <cmath>
+#include <cstdlib>
+#include "texture_manager.h"
+#include "dynamic_resolution.h"
+#include "frame_pacing.h"
+#include "gl_capture.h"
+#include "startup.h"
+#include "trace.h"
+
+// Wspólny szkielet programów z tego katalogu: okno z kontekstem i GLAD, menedżer
+// tekstur, graf startu i pętla renderowania. Sam program to scena (Scene, scenes.h):
+//
+//   int main() { TriangleScene scene; return runScene(scene); }
+//
+// Scena dzieli się na część wspólną, tworzoną raz w kontekście głównym (programy,
+// bufory, tekstury przez TextureManager), i widoki (SceneView) z obiektami, których
+// konteksty nie współdzielą (VAO) i stanem klatki. runScene() otwiera jedno okno
+// z jednym widokiem; viewer.cpp rysuje te same sceny w wielu oknach naraz.
+//
+// Zmienne środowiskowe wspólne dla wszystkich programów:
+//   GPU_BUDGET_MB=n       budżet pamięci GPU na tekstury i bufory
+//   GL_CAPTURE=plik       nagranie poleceń GL (gl_capture.h, odtwarzane przez replay)
+//   TARGET_FRAME_MS=ms    docelowy czas klatki przy zmiennej rozdzielczości
+//   LOW_LATENCY, FRAMES_IN_FLIGHT, LATENCY_STATS: tempo klatek (frame_pacing.h)
+
+// ustawienia
+const unsigned int SCR_WIDTH = 800;
+const unsigned int SCR_HEIGHT = 600;
+// budżet pamięci GPU na tekstury i bufory (w MB)
+const unsigned int GPU_BUDGET_MB = 256;
+// ile bajtów tekstur wysyłać na GPU w jednej klatce
+const size_t TEXTURE_UPLOAD_BUDGET = 2 * 1024 * 1024;
+// docelowy czas GPU klatki (w ms), do którego dopasowywana jest rozdzielczość renderowania
+const float TARGET_FRAME_MS = 16.0f;
+
+// widok sceny w jednym kontekście; tworzony, używany i niszczony w wątku tego kontekstu
+class SceneView
+{
+public:
+    virtual ~SceneView() {}
+    // praca CPU klatki, przed czekaniem na GPU (np. krok symulacji)
+    virtual void update() {}
+    virtual void draw(TextureManager& textures) = 0;
+    virtual void destroy(TextureManager& textures) = 0;
+};
+
+// część sceny wspólna dla wszystkich jej widoków
+class Scene
+{
+public:
+    virtual ~Scene() {}
+    virtual const char* title() const = 0;
+    // wersja kontekstu, o którą prosi scena (np. 43); bez niej wystarcza 3.3
+    virtual int glVersion() const { return 33; }
+    // część bez GL: pliki, źródła shaderów, zlecenie tekstur, dane CPU; w tle, przed kontekstem
+    virtual bool prepare(TextureManager& textures) { return true; }
+    // obiekty współdzielone, raz, w kontekście głównym, po prepare()
+    virtual bool create(TextureManager& textures) = 0;
+    // dalsze części sceny, wczytywane w kontekście głównym po jednej na wywołanie
+    virtual bool complete() const { return true; }
+    virtual void loadMore(TextureManager& textures) {}
+    // widok w bieżącym kontekście; shared = kontekst inny niż główny: widok może wtedy
+    // tylko czytać menedżer tekstur (TextureManager::bindShared), a scena musi być complete()
+    virtual SceneView* createView(TextureManager& textures, bool shared) = 0;
+    virtual void destroy(TextureManager& textures) = 0;
+};
+
+// okno z kontekstem OpenGL core w wersji version (np. 33); z share kontekst współdzieli
+// obiekty z oknem share. Okno bez share staje się bieżące i ładuje GLAD (wskaźniki są
+// wspólne dla kontekstów z tymi samymi ustawieniami). NULL, gdy okna nie da się utworzyć.
+inline GLFWwindow* createWindow(int width, int height, const char* title, int version = 33,
+    GLFWwindow* share = NULL, bool visible = true)
+{
+    // glfw: inicjalizacja i konfiguracja (kolejne wywołania glfwInit nic nie robią)
+    // ---------------------------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version / 10);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version % 10);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+    // glfw: utworzenie okna
+    // --------------------
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(width, height, title, NULL, share);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (window == NULL || share != NULL)
+        return window;
+    glfwMakeContextCurrent(window);
+
+    // glad: załadowanie wskaźników do funkcji OpenGL
+    // --------------------------------------------
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Nie udało się zainicjalizować GLAD" << std::endl;
+        glfwDestroyWindow(window);
+        return NULL;
+    }
+    return window;
+}
+
+// funkcja obsługująca wejście z klawiatury
+inline void processInput(GLFWwindow* window)
+{
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// zmienna rozdzielczość okna runScene(); wskaźnik użytkownika okna zajmuje FramePacer
+inline DynamicResolution*& hostDynamicResolution()
+{
+    static DynamicResolution* resolution = NULL;
+    return resolution;
+}
+
+// funkcja obsługująca zmianę rozmiaru okna
+inline void hostFramebufferSize(GLFWwindow* window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+    if (hostDynamicResolution())
+        hostDynamicResolution()->resize(width, height);
+}
+
+struct HostOptions
+{
+    bool dynamicResolution; // rysowanie w rozdzielczości dobieranej do czasu klatki
+    const char* traceFile;  // ślad przy TRACE_ENABLED; NULL = bez zapisu
+
+    HostOptions() : dynamicResolution(false), traceFile(NULL) {}
+};
+
+// jedno okno z jednym widokiem sceny, aż do zamknięcia okna; wynik dla main()
+inline int runScene(Scene& scene, const HostOptions& options = HostOptions())
+{
+    TRACE_THREAD_NAME("main");
+
+    // tekstury są dekodowane w tle i pojawiają się stopniowo, od najmniejszej mipmapy;
+    // menedżer pilnuje budżetu pamięci GPU (GPU_BUDGET_MB nadpisuje domyślny budżet)
+    size_t budgetMB = GPU_BUDGET_MB;
+    if (const char* env = getenv("GPU_BUDGET_MB"))
+        budgetMB = strtoul(env, NULL, 10);
+    TextureManager textures(budgetMB * 1024 * 1024);
+
+    stbi_set_flip_vertically_on_load(true); // odwrócenie wczytanego obrazu wzdłuż osi y.
+
+    // start jako graf zależności (startup.h): część sceny bez GL rusza w tle od razu,
+    // równolegle z tworzeniem okna i kontekstu; zadania GL czekają tylko na to, czego
+    // naprawdę potrzebują (graf po menedżerze, żeby przy błędzie jego wątki skończyły
+    // się przed zniszczeniem menedżera)
+    StartupGraph startup;
+    StartupGraph::Task prepared = startup.add("przygotowanie sceny", StartupGraph::WORKER, [&]
+    {
+        return scene.prepare(textures);
+    });
+
+    GLFWwindow* window = NULL;
+    StartupGraph::Task context = startup.add("okno i kontekst", StartupGraph::MAIN, [&]
+    {
+        int version = scene.glVersion();
+        window = createWindow(SCR_WIDTH, SCR_HEIGHT, scene.title(), version);
+        if (window == NULL && version > 33)
+        {
+            std::cout << "Brak kontekstu OpenGL " << version / 10 << "." << version % 10 << ", używam 3.3" << std::endl;
+            window = createWindow(SCR_WIDTH, SCR_HEIGHT, scene.title());
+        }
+        if (window == NULL)
+        {
+            std::cout << "Nie udało się utworzyć okna GLFW" << std::endl;
+            return false;
+        }
+        glfwSetFramebufferSizeCallback(window, hostFramebufferSize);
+
+        // GL_CAPTURE=plik.glcap nagrywa wszystkie polecenia GL do odtworzenia programem replay
+        if (const char* capturePath = getenv("GL_CAPTURE"))
+            glcap::begin(capturePath);
+        return true;
+    });
+
+    // limit klatek w locie i pomiar opóźnienia wejścia (frame_pacing.h, LOW_LATENCY=1)
+    FramePacer framePacer;
+    // scena rysowana w zmiennej rozdzielczości i skalowana do rozmiaru okna
+    DynamicResolution dynamicResolution;
+    StartupGraph::Task frameResources = startup.add("bufory klatki", StartupGraph::MAIN, [&]
+    {
+        if (options.dynamicResolution)
+        {
+            // rozdzielczość renderowania dobierana do czasu klatki (TARGET_FRAME_MS nadpisuje cel)
+            float targetMs = TARGET_FRAME_MS;
+            if (const char* env = getenv("TARGET_FRAME_MS"))
+            {
+                char* end = NULL;
+                double value = strtod(env, &end);
+                if (end == env || *end != '\0' || !std::isfinite(value) || value <= 0.0)
+                    std::cout << "BŁĄD::TARGET_FRAME_MS::NIEPRAWIDŁOWA_WARTOŚĆ " << env
+                              << ", używam " << TARGET_FRAME_MS << " ms" << std::endl;
+                else
+                    targetMs = (float)value;
+            }
+            int fbWidth, fbHeight;
+            glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+            if (!dynamicResolution.init(fbWidth, fbHeight, targetMs))
+                return false;
+            hostDynamicResolution() = &dynamicResolution;
+        }
+        return framePacer.init(window);
+    }, { context });
+
+    StartupGraph::Task resources = startup.add("zasoby sceny", StartupGraph::MAIN, [&]
+    {
+        return scene.create(textures);
+    }, { prepared, context });
+
+    SceneView* view = NULL;
+    StartupGraph::Task viewTask = startup.add("widok", StartupGraph::MAIN, [&]
+    {
+        view = scene.createView(textures, false);
+        return view != NULL;
+    }, { resources });
+
+    StartupGraph::Task ready = startup.add("gotowe do pierwszej klatki", StartupGraph::MAIN, [&]
+    {
+        return true;
+    }, { frameResources, viewTask });
+
+    startup.start();
+    if (!startup.run(ready))
+    {
+        hostDynamicResolution() = NULL;
+        glfwTerminate();
+        return -1;
+    }
+    // czasy startu są wypisywane, gdy cała scena i wszystkie tekstury są na GPU
+    bool firstFrame = true, startupReported = false;
+
+    // odkomentuj tę linię, aby rysować trójkąty w trybie siatki.
+    //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+    // pętla renderowania
+    // ------------------
+    while (!glfwWindowShouldClose(window))
+    {
+        TRACE_ZONE("klatka");
+        view->update();
+
+        // obsługa wejścia: w trybie niskiego opóźnienia zdarzenia są odpytywane
+        // dopiero po czekaniu na GPU, tuż przed rysowaniem
+        // ----------------
+        framePacer.beginFrame();
+        {
+            TRACE_ZONE("processInput");
+            if (framePacer.lateInput())
+                glfwPollEvents();
+            processInput(window);
+        }
+
+        // renderowanie
+        // ------------
+        TRACE_GPU_COLLECT();
+        if (options.dynamicResolution)
+            dynamicResolution.begin();
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // kolejne poziomy mipmap tekstur wczytywanych w tle
+        textures.update(TEXTURE_UPLOAD_BUDGET);
+        {
+            TRACE_ZONE("rysowanie");
+            TRACE_GPU_ZONE("rysowanie");
+            view->draw(textures);
+        }
+        textures.endFrame();
+        if (options.dynamicResolution)
+            dynamicResolution.end();
+
+        // obsługa zdarzeń i wymiana buforów
+        glcap::frame();
+        {
+            TRACE_ZONE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
+        framePacer.endFrame();
+        if (!framePacer.lateInput())
+        {
+            TRACE_ZONE("glfwPollEvents");
+            glfwPollEvents();
+        }
+
+        if (firstFrame)
+        {
+            startup.mark("pierwsza klatka");
+            firstFrame = false;
+        }
+        if (!startupReported && scene.complete() && textures.idle())
+        {
+            startup.mark("cała scena i tekstury");
+            startup.printTimings();
+            startupReported = true;
+        }
+
+        // kolejna część sceny, już po wyświetleniu pierwszej klatki
+        if (!scene.complete())
+            scene.loadMore(textures);
+    }
+    if (options.traceFile)
+        TRACE_WRITE(options.traceFile);
+
+    // zwolnienie zasobów
+    view->destroy(textures);
+    delete view;
+    scene.destroy(textures);
+    framePacer.destroy();
+    if (options.dynamicResolution)
+        dynamicResolution.destroy();
+    hostDynamicResolution() = NULL;
+    textures.printStats();
+    textures.destroy();
+
+    glcap::end();
+
+    // glfw: zakończenie, zwolnienie zasobów
+    glfwTerminate();
+    return 0;
+}
+
+#endif
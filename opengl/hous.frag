@@ -0,0 +1,8 @@
+#version 330 core
+in vec2 TexCoord;
+out vec4 FragColor;
+uniform sampler2D texture1;
+void main()
+{
+   FragColor = texture(texture1, TexCoord);
+}
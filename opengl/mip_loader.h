@@ -0,0 +1,155 @@
+#ifndef MIP_LOADER_H
+#define MIP_LOADER_H
+
+#include <stb_image.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "trace.h"
+
+// Łańcuch mipmap przygotowany na CPU: poziom 0 to pełny obraz RGBA8,
+// każdy kolejny jest dwa razy mniejszy (filtr 2x2), aż do 1x1.
+struct MipChain
+{
+    struct Level
+    {
+        int width, height;
+        std::vector<unsigned char> pixels;
+    };
+    std::vector<Level> levels;
+};
+
+// Wątek w tle dekodujący obrazy i budujący z nich łańcuchy mipmap,
+// żeby wątek renderujący nie czekał na stbi_load.
+class MipLoader
+{
+public:
+    struct Result
+    {
+        unsigned int id;
+        std::shared_ptr<MipChain> chain; // pusty wskaźnik przy błędzie wczytywania
+    };
+
+    MipLoader() : quit(false)
+    {
+        worker = std::thread(&MipLoader::run, this);
+    }
+
+    ~MipLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // zlecenie wczytania; wynik z tym samym id pojawi się w poll()
+    void request(unsigned int id, const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(Job{ id, path });
+        }
+        wake.notify_one();
+    }
+
+    // zabranie gotowych wyników (nie blokuje)
+    std::vector<Result> poll()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Result> ready;
+        ready.swap(done);
+        return ready;
+    }
+
+    static std::shared_ptr<MipChain> build(const std::string& path)
+    {
+        TRACE_ZONE("dekodowanie tekstury");
+        int width, height, nrChannels;
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 4);
+        if (!data)
+            return std::shared_ptr<MipChain>();
+
+        std::shared_ptr<MipChain> chain(new MipChain);
+        MipChain::Level base;
+        base.width = width;
+        base.height = height;
+        base.pixels.assign(data, data + (size_t)width * height * 4);
+        stbi_image_free(data);
+        chain->levels.push_back(std::move(base));
+
+        TRACE_ZONE("generowanie mipmap");
+        while (chain->levels.back().width > 1 || chain->levels.back().height > 1)
+            chain->levels.push_back(downsample(chain->levels.back()));
+        return chain;
+    }
+
+private:
+    struct Job
+    {
+        unsigned int id;
+        std::string path;
+    };
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    std::vector<Result> done;
+    bool quit;
+
+    void run()
+    {
+        TRACE_THREAD_NAME("MipLoader");
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return quit || !jobs.empty(); });
+                if (quit)
+                    return;
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            Result result = { job.id, build(job.path) };
+            std::lock_guard<std::mutex> lock(mutex);
+            done.push_back(result);
+        }
+    }
+
+    // uśrednienie bloków 2x2; przy nieparzystym wymiarze ostatni wiersz/kolumna jest powielany
+    static MipChain::Level downsample(const MipChain::Level& src)
+    {
+        MipChain::Level dst;
+        dst.width = src.width > 1 ? src.width / 2 : 1;
+        dst.height = src.height > 1 ? src.height / 2 : 1;
+        dst.pixels.resize((size_t)dst.width * dst.height * 4);
+        for (int y = 0; y < dst.height; y++)
+        {
+            int y0 = y * 2 < src.height ? y * 2 : src.height - 1;
+            int y1 = y * 2 + 1 < src.height ? y * 2 + 1 : src.height - 1;
+            for (int x = 0; x < dst.width; x++)
+            {
+                int x0 = x * 2 < src.width ? x * 2 : src.width - 1;
+                int x1 = x * 2 + 1 < src.width ? x * 2 + 1 : src.width - 1;
+                const unsigned char* a = &src.pixels[((size_t)y0 * src.width + x0) * 4];
+                const unsigned char* b = &src.pixels[((size_t)y0 * src.width + x1) * 4];
+                const unsigned char* c = &src.pixels[((size_t)y1 * src.width + x0) * 4];
+                const unsigned char* d = &src.pixels[((size_t)y1 * src.width + x1) * 4];
+                unsigned char* out = &dst.pixels[((size_t)y * dst.width + x) * 4];
+                for (int i = 0; i < 4; i++)
+                    out[i] = (unsigned char)((a[i] + b[i] + c[i] + d[i] + 2) / 4);
+            }
+        }
+        return dst;
+    }
+};
+
+#endif
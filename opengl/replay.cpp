@@ -0,0 +1,544 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include "gl_capture.h"
+
+// Odtwarzacz nagrań z gl_capture.h.
+// Wczytuje cały plik jednym odczytem, tworzy niewidoczne okno z kontekstem GL
+// i wykonuje nagrane polecenia najszybciej jak się da, do pozaekranowego
+// framebuffera (nagrany framebuffer 0 jest podmieniany na ten bufor).
+// Dla każdej klatki mierzy czas CPU wysyłania poleceń i czas GPU (GL_TIME_ELAPSED).
+// Nagrane zapytania GL_TIME_ELAPSED nie mogą się zagnieżdżać w tym pomiarze,
+// więc są odtwarzane jako para znaczników GL_TIMESTAMP na tym samym obiekcie.
+//
+// użycie: replay <nagranie.glcap> [wyniki.csv]
+
+// odczyt rekordów nagrania
+struct Reader
+{
+    const unsigned char* p;
+    const unsigned char* end;
+
+    uint32_t u32() { uint32_t v; memcpy(&v, p, 4); p += 4; return v; }
+    int32_t i32() { int32_t v; memcpy(&v, p, 4); p += 4; return v; }
+    uint64_t u64() { uint64_t v; memcpy(&v, p, 8); p += 8; return v; }
+    float f32() { float v; memcpy(&v, p, 4); p += 4; return v; }
+    const unsigned char* blob(uint32_t& size)
+    {
+        size = u32();
+        const unsigned char* data = size ? p : NULL;
+        p += size;
+        return data;
+    }
+};
+
+// mapowanie nazw obiektów z nagrania na nazwy w bieżącym kontekście
+struct Names
+{
+    std::map<GLuint, GLuint> buffers, vertexArrays, shaders, programs, textures, framebuffers, renderbuffers, queries;
+    std::map<GLenum, GLuint> activeQueries; // cel -> zapytanie (już przemapowane)
+    std::map<std::pair<GLuint, GLint>, GLint> uniforms;
+    std::map<std::pair<GLuint, GLuint>, GLuint> blocks;
+    std::map<uint64_t, GLsync> syncs;
+    GLuint defaultFramebuffer;
+    GLuint currentProgram;
+
+    static GLuint get(const std::map<GLuint, GLuint>& names, GLuint name)
+    {
+        std::map<GLuint, GLuint>::const_iterator it = names.find(name);
+        return it == names.end() ? 0 : it->second;
+    }
+
+    GLuint framebuffer(GLuint name) const { return name == 0 ? defaultFramebuffer : get(framebuffers, name); }
+
+    GLint uniform(GLint location) const
+    {
+        std::map<std::pair<GLuint, GLint>, GLint>::const_iterator it = uniforms.find(std::make_pair(currentProgram, location));
+        return it == uniforms.end() ? location : it->second;
+    }
+};
+
+typedef void (APIENTRY *GenFunc)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteFunc)(GLsizei, const GLuint*);
+
+static void genNames(Reader& in, std::map<GLuint, GLuint>& names, GenFunc gen)
+{
+    GLsizei n = in.i32();
+    for (GLsizei i = 0; i < n; i++)
+    {
+        GLuint name;
+        gen(1, &name);
+        names[in.u32()] = name;
+    }
+}
+
+static void deleteNames(Reader& in, std::map<GLuint, GLuint>& names, DeleteFunc del)
+{
+    GLsizei n = in.i32();
+    for (GLsizei i = 0; i < n; i++)
+    {
+        GLuint captured = in.u32();
+        GLuint name = Names::get(names, captured);
+        del(1, &name);
+        names.erase(captured);
+    }
+}
+
+// wykonanie jednego rekordu; zwraca false dla nieznanego rekordu
+static bool execute(uint16_t op, Reader& in, Names& names)
+{
+    using namespace glcap;
+    uint32_t size;
+    switch (op)
+    {
+    case OP_FRAME_END:
+        // odpowiednik wysłania poleceń przy glfwSwapBuffers
+        glFlush();
+        break;
+
+    case OP_GEN_BUFFERS: genNames(in, names.buffers, glad_glGenBuffers); break;
+    case OP_DELETE_BUFFERS: deleteNames(in, names.buffers, glad_glDeleteBuffers); break;
+    case OP_BIND_BUFFER: { GLenum t = in.u32(); glBindBuffer(t, Names::get(names.buffers, in.u32())); break; }
+    case OP_BUFFER_DATA:
+    {
+        GLenum t = in.u32(); GLsizeiptr s = (GLsizeiptr)in.u64(); GLenum usage = in.u32();
+        glBufferData(t, s, in.blob(size), usage);
+        break;
+    }
+    case OP_BUFFER_STORAGE:
+    {
+        // zmapowane zapisy są odtwarzane przez glBufferSubData, więc bufor musi być modyfikowalny
+        GLenum t = in.u32(); GLsizeiptr s = (GLsizeiptr)in.u64(); in.u32();
+        glBufferData(t, s, in.blob(size), GL_DYNAMIC_DRAW);
+        break;
+    }
+    case OP_BUFFER_SUB_DATA:
+    {
+        GLenum t = in.u32(); GLintptr o = (GLintptr)in.u64();
+        const unsigned char* data = in.blob(size);
+        glBufferSubData(t, o, size, data);
+        break;
+    }
+    case OP_BUFFER_WRITE:
+    {
+        GLuint b = Names::get(names.buffers, in.u32()); GLintptr o = (GLintptr)in.u64();
+        const unsigned char* data = in.blob(size);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, b);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, o, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        break;
+    }
+    case OP_BIND_BUFFER_RANGE:
+    {
+        GLenum t = in.u32(); GLuint i = in.u32(); GLuint b = Names::get(names.buffers, in.u32());
+        GLintptr o = (GLintptr)in.u64(); GLsizeiptr s = (GLsizeiptr)in.u64();
+        glBindBufferRange(t, i, b, o, s);
+        break;
+    }
+    case OP_BIND_BUFFER_BASE:
+    {
+        GLenum t = in.u32(); GLuint i = in.u32();
+        glBindBufferBase(t, i, Names::get(names.buffers, in.u32()));
+        break;
+    }
+
+    case OP_GEN_VERTEX_ARRAYS: genNames(in, names.vertexArrays, glad_glGenVertexArrays); break;
+    case OP_DELETE_VERTEX_ARRAYS: deleteNames(in, names.vertexArrays, glad_glDeleteVertexArrays); break;
+    case OP_BIND_VERTEX_ARRAY: glBindVertexArray(Names::get(names.vertexArrays, in.u32())); break;
+    case OP_VERTEX_ATTRIB_POINTER:
+    {
+        GLuint i = in.u32(); GLint s = in.i32(); GLenum t = in.u32(); GLboolean n = (GLboolean)in.u32();
+        GLsizei stride = in.i32(); uint64_t offset = in.u64();
+        glVertexAttribPointer(i, s, t, n, stride, (void*)(uintptr_t)offset);
+        break;
+    }
+    case OP_VERTEX_ATTRIB_I_POINTER:
+    {
+        GLuint i = in.u32(); GLint s = in.i32(); GLenum t = in.u32();
+        GLsizei stride = in.i32(); uint64_t offset = in.u64();
+        glVertexAttribIPointer(i, s, t, stride, (void*)(uintptr_t)offset);
+        break;
+    }
+    case OP_ENABLE_VERTEX_ATTRIB_ARRAY: glEnableVertexAttribArray(in.u32()); break;
+    case OP_DISABLE_VERTEX_ATTRIB_ARRAY: glDisableVertexAttribArray(in.u32()); break;
+    case OP_VERTEX_ATTRIB_DIVISOR: { GLuint i = in.u32(); glVertexAttribDivisor(i, in.u32()); break; }
+
+    case OP_CREATE_SHADER: { GLenum t = in.u32(); names.shaders[in.u32()] = glCreateShader(t); break; }
+    case OP_SHADER_SOURCE:
+    {
+        GLuint s = Names::get(names.shaders, in.u32());
+        const GLchar* source = (const GLchar*)in.blob(size);
+        GLint length = (GLint)size;
+        glShaderSource(s, 1, &source, &length);
+        break;
+    }
+    case OP_COMPILE_SHADER: glCompileShader(Names::get(names.shaders, in.u32())); break;
+    case OP_DELETE_SHADER: { GLuint s = in.u32(); glDeleteShader(Names::get(names.shaders, s)); names.shaders.erase(s); break; }
+    case OP_CREATE_PROGRAM: names.programs[in.u32()] = glCreateProgram(); break;
+    case OP_ATTACH_SHADER:
+    {
+        GLuint p = Names::get(names.programs, in.u32());
+        glAttachShader(p, Names::get(names.shaders, in.u32()));
+        break;
+    }
+    case OP_LINK_PROGRAM: glLinkProgram(Names::get(names.programs, in.u32())); break;
+    case OP_USE_PROGRAM: names.currentProgram = Names::get(names.programs, in.u32()); glUseProgram(names.currentProgram); break;
+    case OP_DELETE_PROGRAM: { GLuint p = in.u32(); glDeleteProgram(Names::get(names.programs, p)); names.programs.erase(p); break; }
+    case OP_GET_UNIFORM_LOCATION:
+    {
+        GLuint captured = in.u32(); GLint location = in.i32();
+        const GLchar* name = (const GLchar*)in.blob(size);
+        GLuint p = Names::get(names.programs, captured);
+        names.uniforms[std::make_pair(p, location)] = glGetUniformLocation(p, name);
+        break;
+    }
+    case OP_GET_UNIFORM_BLOCK_INDEX:
+    {
+        GLuint captured = in.u32(); GLuint index = in.u32();
+        const GLchar* name = (const GLchar*)in.blob(size);
+        GLuint p = Names::get(names.programs, captured);
+        names.blocks[std::make_pair(p, index)] = glGetUniformBlockIndex(p, name);
+        break;
+    }
+    case OP_UNIFORM_BLOCK_BINDING:
+    {
+        GLuint p = Names::get(names.programs, in.u32()); GLuint index = in.u32(); GLuint binding = in.u32();
+        std::map<std::pair<GLuint, GLuint>, GLuint>::iterator it = names.blocks.find(std::make_pair(p, index));
+        glUniformBlockBinding(p, it == names.blocks.end() ? index : it->second, binding);
+        break;
+    }
+    case OP_UNIFORM_1I: { GLint l = names.uniform(in.i32()); glUniform1i(l, in.i32()); break; }
+    case OP_UNIFORM_1F: { GLint l = names.uniform(in.i32()); glUniform1f(l, in.f32()); break; }
+    case OP_UNIFORM_4F:
+    {
+        GLint l = names.uniform(in.i32());
+        float x = in.f32(), y = in.f32(), z = in.f32(), w = in.f32();
+        glUniform4f(l, x, y, z, w);
+        break;
+    }
+    case OP_UNIFORM_MATRIX_4FV:
+    {
+        GLint l = names.uniform(in.i32()); GLboolean transpose = (GLboolean)in.u32();
+        const GLfloat* value = (const GLfloat*)in.blob(size);
+        glUniformMatrix4fv(l, size / (16 * sizeof(GLfloat)), transpose, value);
+        break;
+    }
+
+    case OP_GEN_TEXTURES: genNames(in, names.textures, glad_glGenTextures); break;
+    case OP_DELETE_TEXTURES: deleteNames(in, names.textures, glad_glDeleteTextures); break;
+    case OP_BIND_TEXTURE: { GLenum t = in.u32(); glBindTexture(t, Names::get(names.textures, in.u32())); break; }
+    case OP_ACTIVE_TEXTURE: glActiveTexture(in.u32()); break;
+    case OP_TEX_PARAMETER_I: { GLenum t = in.u32(); GLenum p = in.u32(); glTexParameteri(t, p, in.i32()); break; }
+    case OP_TEX_PARAMETER_F: { GLenum t = in.u32(); GLenum p = in.u32(); glTexParameterf(t, p, in.f32()); break; }
+    case OP_TEX_IMAGE_2D:
+    {
+        GLenum t = in.u32(); GLint level = in.i32(); GLint internal = in.i32();
+        GLsizei w = in.i32(), h = in.i32(); GLenum format = in.u32(), type = in.u32();
+        glTexImage2D(t, level, internal, w, h, 0, format, type, in.blob(size));
+        break;
+    }
+    case OP_TEX_SUB_IMAGE_2D:
+    {
+        GLenum t = in.u32(); GLint level = in.i32(); GLint x = in.i32(), y = in.i32();
+        GLsizei w = in.i32(), h = in.i32(); GLenum format = in.u32(), type = in.u32();
+        glTexSubImage2D(t, level, x, y, w, h, format, type, in.blob(size));
+        break;
+    }
+    case OP_GENERATE_MIPMAP: glGenerateMipmap(in.u32()); break;
+    case OP_PIXEL_STORE_I: { GLenum p = in.u32(); glPixelStorei(p, in.i32()); break; }
+
+    case OP_GEN_FRAMEBUFFERS: genNames(in, names.framebuffers, glad_glGenFramebuffers); break;
+    case OP_DELETE_FRAMEBUFFERS: deleteNames(in, names.framebuffers, glad_glDeleteFramebuffers); break;
+    case OP_BIND_FRAMEBUFFER: { GLenum t = in.u32(); glBindFramebuffer(t, names.framebuffer(in.u32())); break; }
+    case OP_FRAMEBUFFER_TEXTURE_2D:
+    {
+        GLenum t = in.u32(), a = in.u32(), tt = in.u32(); GLuint tex = Names::get(names.textures, in.u32());
+        glFramebufferTexture2D(t, a, tt, tex, in.i32());
+        break;
+    }
+    case OP_GEN_RENDERBUFFERS: genNames(in, names.renderbuffers, glad_glGenRenderbuffers); break;
+    case OP_DELETE_RENDERBUFFERS: deleteNames(in, names.renderbuffers, glad_glDeleteRenderbuffers); break;
+    case OP_BIND_RENDERBUFFER: { GLenum t = in.u32(); glBindRenderbuffer(t, Names::get(names.renderbuffers, in.u32())); break; }
+    case OP_RENDERBUFFER_STORAGE:
+    {
+        GLenum t = in.u32(), f = in.u32(); GLsizei w = in.i32(), h = in.i32();
+        glRenderbufferStorage(t, f, w, h);
+        break;
+    }
+    case OP_FRAMEBUFFER_RENDERBUFFER:
+    {
+        GLenum t = in.u32(), a = in.u32(), rt = in.u32();
+        glFramebufferRenderbuffer(t, a, rt, Names::get(names.renderbuffers, in.u32()));
+        break;
+    }
+    case OP_BLIT_FRAMEBUFFER:
+    {
+        GLint v[8];
+        for (int i = 0; i < 8; i++)
+            v[i] = in.i32();
+        GLbitfield mask = in.u32(); GLenum filter = in.u32();
+        glBlitFramebuffer(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], mask, filter);
+        break;
+    }
+
+    case OP_VIEWPORT: { GLint x = in.i32(), y = in.i32(); GLsizei w = in.i32(), h = in.i32(); glViewport(x, y, w, h); break; }
+    case OP_SCISSOR: { GLint x = in.i32(), y = in.i32(); GLsizei w = in.i32(), h = in.i32(); glScissor(x, y, w, h); break; }
+    case OP_ENABLE: glEnable(in.u32()); break;
+    case OP_DISABLE: glDisable(in.u32()); break;
+    case OP_CLEAR_COLOR: { float r = in.f32(), g = in.f32(), b = in.f32(), a = in.f32(); glClearColor(r, g, b, a); break; }
+    case OP_CLEAR: glClear(in.u32()); break;
+    case OP_POLYGON_MODE: { GLenum f = in.u32(); glPolygonMode(f, in.u32()); break; }
+    case OP_DRAW_ARRAYS: { GLenum m = in.u32(); GLint first = in.i32(); glDrawArrays(m, first, in.i32()); break; }
+    case OP_DRAW_ELEMENTS:
+    {
+        GLenum m = in.u32(); GLsizei count = in.i32(); GLenum t = in.u32(); uint64_t offset = in.u64();
+        glDrawElements(m, count, t, (void*)(uintptr_t)offset);
+        break;
+    }
+    case OP_DRAW_ARRAYS_INSTANCED:
+    {
+        GLenum m = in.u32(); GLint first = in.i32(); GLsizei count = in.i32();
+        glDrawArraysInstanced(m, first, count, in.i32());
+        break;
+    }
+    case OP_DRAW_ELEMENTS_INSTANCED:
+    {
+        GLenum m = in.u32(); GLsizei count = in.i32(); GLenum t = in.u32(); uint64_t offset = in.u64();
+        glDrawElementsInstanced(m, count, t, (void*)(uintptr_t)offset, in.i32());
+        break;
+    }
+
+    case OP_UNIFORM_1UI: { GLint l = names.uniform(in.i32()); glUniform1ui(l, in.u32()); break; }
+    case OP_UNIFORM_4FV:
+    {
+        GLint l = names.uniform(in.i32());
+        const GLfloat* value = (const GLfloat*)in.blob(size);
+        glUniform4fv(l, size / (4 * sizeof(GLfloat)), value);
+        break;
+    }
+    case OP_TEX_BUFFER:
+    {
+        GLenum t = in.u32(), f = in.u32();
+        glTexBuffer(t, f, Names::get(names.buffers, in.u32()));
+        break;
+    }
+
+#ifdef GL_COMPUTE_SHADER
+    case OP_DISPATCH_COMPUTE: { GLuint x = in.u32(), y = in.u32(), z = in.u32(); glDispatchCompute(x, y, z); break; }
+    case OP_MEMORY_BARRIER: glMemoryBarrier(in.u32()); break;
+    case OP_CLEAR_BUFFER_DATA:
+    {
+        GLenum t = in.u32(), internal = in.u32(), format = in.u32(), type = in.u32();
+        glClearBufferData(t, internal, format, type, in.blob(size));
+        break;
+    }
+    case OP_MULTI_DRAW_ARRAYS_INDIRECT:
+    {
+        GLenum m = in.u32(); uint64_t offset = in.u64(); GLsizei count = in.i32();
+        glMultiDrawArraysIndirect(m, (void*)(uintptr_t)offset, count, in.i32());
+        break;
+    }
+#endif
+
+    case OP_GEN_QUERIES: genNames(in, names.queries, glad_glGenQueries); break;
+    case OP_DELETE_QUERIES: deleteNames(in, names.queries, glad_glDeleteQueries); break;
+    case OP_BEGIN_QUERY:
+    {
+        GLenum t = in.u32(); GLuint q = Names::get(names.queries, in.u32());
+        names.activeQueries[t] = q;
+        if (t == GL_TIME_ELAPSED)
+            glQueryCounter(q, GL_TIMESTAMP);
+        else
+            glBeginQuery(t, q);
+        break;
+    }
+    case OP_END_QUERY:
+    {
+        GLenum t = in.u32();
+        if (t == GL_TIME_ELAPSED)
+            glQueryCounter(names.activeQueries[t], GL_TIMESTAMP);
+        else
+            glEndQuery(t);
+        names.activeQueries.erase(t);
+        break;
+    }
+    case OP_QUERY_COUNTER: { GLuint q = Names::get(names.queries, in.u32()); glQueryCounter(q, in.u32()); break; }
+
+    case OP_FENCE_SYNC: names.syncs[in.u64()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); break;
+    case OP_CLIENT_WAIT_SYNC:
+    {
+        uint64_t id = in.u64(); GLbitfield flags = in.u32(); GLuint64 timeout = in.u64();
+        if (names.syncs.count(id))
+            glClientWaitSync(names.syncs[id], flags, timeout);
+        break;
+    }
+    case OP_DELETE_SYNC:
+    {
+        uint64_t id = in.u64();
+        if (names.syncs.count(id))
+            glDeleteSync(names.syncs[id]);
+        names.syncs.erase(id);
+        break;
+    }
+
+    default:
+        std::cout << "Nieznany rekord nagrania: " << op << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Użycie: replay <nagranie.glcap> [wyniki.csv]" << std::endl;
+        return -1;
+    }
+
+    // wczytanie całego nagrania jednym odczytem
+    std::ifstream file(argv[1], std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        std::cout << "Nie udało się otworzyć nagrania: " << argv[1] << std::endl;
+        return -1;
+    }
+    std::vector<unsigned char> trace((size_t)file.tellg());
+    file.seekg(0);
+    file.read((char*)trace.data(), trace.size());
+
+    uint32_t header[6];
+    if (trace.size() < sizeof(header))
+    {
+        std::cout << "Nagranie jest za krótkie" << std::endl;
+        return -1;
+    }
+    memcpy(header, trace.data(), sizeof(header));
+    if (header[0] != glcap::MAGIC || header[1] != glcap::VERSION)
+    {
+        std::cout << "To nie jest nagranie gl_capture (albo inna wersja formatu)" << std::endl;
+        return -1;
+    }
+
+    // glfw: niewidoczne okno z kontekstem w nagranej wersji GL
+    // ---------------------------------------------------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, header[2] < 3 ? 3 : header[2]);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, header[2] < 3 ? 3 : header[3]);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(64, 64, "Replay", NULL, NULL);
+    if (window == NULL)
+    {
+        std::cout << "Nie udało się utworzyć okna GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Nie udało się zainicjalizować GLAD" << std::endl;
+        return -1;
+    }
+
+    // pozaekranowy odpowiednik domyślnego framebuffera z nagrania
+    GLsizei width = header[4] ? header[4] : 800, height = header[5] ? header[5] : 600;
+    GLuint fbo, colorBuffer;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glViewport(0, 0, width, height);
+
+    Names names;
+    names.defaultFramebuffer = fbo;
+    names.currentProgram = 0;
+
+    // odtwarzanie: czas CPU wysyłania każdej klatki i czas GPU z zapytań
+    Reader in = { trace.data() + sizeof(header), trace.data() + trace.size() };
+    std::vector<double> cpuMs;
+    std::vector<GLuint> queries;
+    GLuint query;
+    glGenQueries(1, &query);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    queries.push_back(query);
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    while (in.p + 6 <= in.end)
+    {
+        uint16_t op;
+        uint32_t size;
+        memcpy(&op, in.p, 2);
+        memcpy(&size, in.p + 2, 4);
+        in.p += 6;
+        const unsigned char* next = in.p + size;
+        if (next > in.end || !execute(op, in, names))
+            break;
+        in.p = next;
+        if (op == glcap::OP_FRAME_END)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            cpuMs.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+            frameStart = now;
+            glGenQueries(1, &query);
+            glBeginQuery(GL_TIME_ELAPSED, query);
+            queries.push_back(query);
+        }
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glFinish();
+
+    std::vector<double> gpuMs(cpuMs.size());
+    for (size_t i = 0; i < cpuMs.size(); i++)
+    {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &ns);
+        gpuMs[i] = ns / 1000000.0;
+    }
+    glDeleteQueries((GLsizei)queries.size(), queries.data());
+
+    if (argc > 2)
+    {
+        std::ofstream csv(argv[2]);
+        csv << "klatka,cpu_ms,gpu_ms\n";
+        for (size_t i = 0; i < cpuMs.size(); i++)
+            csv << i << "," << cpuMs[i] << "," << gpuMs[i] << "\n";
+    }
+
+    // podsumowanie; klatka 0 zawiera tworzenie zasobów, więc liczona jest osobno
+    std::cout << "Klatek: " << cpuMs.size() << std::endl;
+    if (!cpuMs.empty())
+        std::cout << "Klatka 0 (z tworzeniem zasobów): CPU " << cpuMs[0] << " ms, GPU " << gpuMs[0] << " ms" << std::endl;
+    if (cpuMs.size() > 1)
+    {
+        std::vector<double> cpu(cpuMs.begin() + 1, cpuMs.end()), gpu(gpuMs.begin() + 1, gpuMs.end());
+        std::sort(cpu.begin(), cpu.end());
+        std::sort(gpu.begin(), gpu.end());
+        double cpuSum = 0, gpuSum = 0;
+        for (size_t i = 0; i < cpu.size(); i++)
+        {
+            cpuSum += cpu[i];
+            gpuSum += gpu[i];
+        }
+        size_t p95 = cpu.size() * 95 / 100;
+        std::cout << "CPU ms: śr " << cpuSum / cpu.size() << ", min " << cpu.front() << ", p95 " << cpu[p95] << ", max " << cpu.back() << std::endl;
+        std::cout << "GPU ms: śr " << gpuSum / gpu.size() << ", min " << gpu.front() << ", p95 " << gpu[p95] << ", max " << gpu.back() << std::endl;
+    }
+
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,429 @@
+#ifndef SAND_H
+#define SAND_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "worker_pool.h"
+#include "trace.h"
+
+#if !defined(SAND_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SAND_SSE2
+#include <emmintrin.h>
+#endif
+
+// Symulacja piasku w klepsydrze: dwie komory z hourglass.cpp (trójkąty o podstawach
+// y = +-HALF_HEIGHT i wierzchołkach w środku), połączone szyjką o półszerokości NECK.
+//
+// Dynamika oparta na pozycjach. Cząstki są w tablicach SoA (x, y, vx, vy oraz
+// pozycje z początku kroku ox, oy). Każdy krok:
+//   1. przewidywanie pozycji z prędkości i grawitacji, ograniczenie ścianami,
+//   2. siatka jednorodna o boku = średnica cząstki: sortowanie przez zliczanie,
+//      które fizycznie przestawia tablice, więc cząstki z jednej komórki (i z całego
+//      wiersza sąsiednich komórek) leżą obok siebie w pamięci,
+//   3. ITERATIONS razy: rozsuwanie nachodzących na siebie cząstek (każda liczy własne
+//      przesunięcie z sąsiadów z 3x3 komórek, bez zapisu do cudzych danych, więc bez
+//      blokad) i ponowne ograniczenie ścianami,
+//   4. prędkość = przesunięcie w kroku / dt, z tarciem dla cząstek w kontakcie.
+// Przy rozsuwaniu wyżej leżąca cząstka przejmuje większą część korekty (skalowanie
+// masy z wysokością), dzięki czemu stos nie zapada się pod własnym ciężarem. Żeby to
+// nie wyrzucało piasku do góry, kontakt może zatrzymać cząstkę, ale nie nadać jej
+// prędkości w górę; prędkość jest też ograniczona do jednej średnicy na krok.
+// Wszystkie etapy poza sortowaniem idą równolegle na WorkerPool, a pętle wewnętrzne
+// po 4 cząstki w SSE2 (-DSAND_NO_SIMD wymusza wersję skalarną).
+class SandSimulation
+{
+public:
+    static constexpr float HALF_HEIGHT = 0.6f;
+    static constexpr float HALF_WIDTH = 0.4f;  // połowa podstawy komory
+    static constexpr float NECK = 0.02f;       // połowa szerokości szyjki
+    static constexpr float GRAVITY = -2.0f;
+
+    SandSimulation(size_t particles, WorkerPool& workers) : pool(workers)
+    {
+        // średnica tak, żeby wszystkie cząstki zmieściły się w górnej komorze
+        float chamberArea = HALF_WIDTH * HALF_HEIGHT;
+        diameter = 0.9f * std::sqrt(chamberArea / (float)(particles > 0 ? particles : 1));
+        radius = diameter * 0.5f;
+
+        gridMinX = -HALF_WIDTH - NECK - diameter;
+        gridMinY = -HALF_HEIGHT - diameter;
+        invCell = 1.0f / diameter;
+        gridWidth = (int)((2.0f * (HALF_WIDTH + NECK + diameter)) * invCell) + 1;
+        gridHeight = (int)((2.0f * (HALF_HEIGHT + diameter)) * invCell) + 1;
+        cellStart.resize((size_t)gridWidth * gridHeight + 1);
+
+        fill(particles);
+        n = x.size();
+        // dopełnienie do pełnej czwórki za ostatnią cząstką dla odczytów SIMD w collide();
+        // resize bierze referencję, a FAR przed C++17 nie ma definicji poza klasą, stąd kopia
+        const float far = FAR;
+        x.resize(n + PADDING, far);
+        y.resize(n + PADDING, far);
+        vx.assign(n, 0.0f);
+        vy.assign(n, 0.0f);
+        ox.resize(n);
+        oy.resize(n);
+        dx.assign(n, 0.0f);
+        dy.assign(n, 0.0f);
+        contact.assign(n, 0.0f);
+        cells.resize(n);
+        sx.assign(n + PADDING, far);
+        sy.assign(n + PADDING, far);
+        sox.resize(n);
+        soy.resize(n);
+    }
+
+    size_t count() const { return n; }
+    float particleRadius() const { return radius; }
+
+    static const char* simdName()
+    {
+#ifdef SAND_SSE2
+        return "SSE2";
+#else
+        return "skalarnie";
+#endif
+    }
+
+    void step(float dt)
+    {
+        TRACE_ZONE("piasek: krok");
+        pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end) { predict(begin, end, dt); });
+        buildGrid();
+        for (int it = 0; it < ITERATIONS; it++)
+        {
+            pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end) { collide(begin, end); });
+            pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end) { apply(begin, end); });
+        }
+        pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end) { updateVelocity(begin, end, 1.0f / dt); });
+    }
+
+    // zapis pozycji jako par (x, y) float, np. do zmapowanego bufora wierzchołków
+    void writePositions(float* dst)
+    {
+        TRACE_ZONE("piasek: zapis wierzchołków");
+        pool.parallelFor(count(), GRAIN, [&](size_t begin, size_t end)
+        {
+            size_t i = begin;
+#ifdef SAND_SSE2
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 px = _mm_loadu_ps(&x[i]);
+                __m128 py = _mm_loadu_ps(&y[i]);
+                _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(px, py));
+                _mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(px, py));
+            }
+#endif
+            for (; i < end; i++)
+            {
+                dst[i * 2] = x[i];
+                dst[i * 2 + 1] = y[i];
+            }
+        });
+    }
+
+private:
+    static const size_t GRAIN = 4096;
+    static const size_t PADDING = 3;
+    static constexpr float FAR = 1e9f;
+    static const int ITERATIONS = 4;
+    // jak szybko rośnie udział wyższej cząstki w korekcie (na średnicę różnicy wysokości)
+    static constexpr float STACKING = 2.0f;
+    // mnożnik uśrednionej korekty (Jacobi z nadrelaksacją)
+    static constexpr float RELAXATION = 1.5f;
+    // część prędkości zachowywana przez cząstkę w kontakcie z innymi / swobodną
+    static constexpr float CONTACT_FRICTION = 0.8f;
+    static constexpr float DAMPING = 0.999f;
+
+    WorkerPool& pool;
+    size_t n;
+    float diameter, radius;
+    float gridMinX, gridMinY, invCell;
+    int gridWidth, gridHeight;
+
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> ox, oy;             // pozycje z początku kroku
+    std::vector<float> dx, dy;             // przesunięcia z bieżącej iteracji
+    std::vector<float> contact;            // liczba sąsiadów, z którymi cząstka się styka
+    std::vector<float> sx, sy, sox, soy;   // bufory docelowe sortowania
+    std::vector<uint32_t> cells;
+    std::vector<uint32_t> cellStart;       // cząstki komórki c: [cellStart[c], cellStart[c + 1])
+
+    // górna komora wypełniana rzędami od góry, z lekkim przesunięciem co drugi rząd
+    void fill(size_t particles)
+    {
+        x.reserve(particles);
+        y.reserve(particles);
+        float spacing = diameter * 1.05f;
+        uint32_t seed = 12345;
+        for (int row = 0; x.size() < particles; row++)
+        {
+            float py = HALF_HEIGHT - radius - row * spacing * 0.87f;
+            if (py < radius)
+                break;
+            float halfWidth = NECK + (HALF_WIDTH / HALF_HEIGHT) * py - radius;
+            float px = -halfWidth + ((row & 1) ? spacing * 0.5f : 0.0f);
+            for (; px <= halfWidth && x.size() < particles; px += spacing)
+            {
+                // drobny szum, żeby cząstki nie leżały idealnie w kolumnach
+                seed = seed * 1664525u + 1013904223u;
+                x.push_back(px + ((seed >> 8) * (1.0f / 16777216.0f) - 0.5f) * diameter * 0.05f);
+                y.push_back(py);
+            }
+        }
+    }
+
+    int cellX(float px) const
+    {
+        int c = (int)((px - gridMinX) * invCell);
+        return c < 0 ? 0 : (c >= gridWidth ? gridWidth - 1 : c);
+    }
+
+    int cellY(float py) const
+    {
+        int c = (int)((py - gridMinY) * invCell);
+        return c < 0 ? 0 : (c >= gridHeight ? gridHeight - 1 : c);
+    }
+
+    // sortowanie przez zliczanie po indeksie komórki (wierszami)
+    void buildGrid()
+    {
+        TRACE_ZONE("piasek: siatka");
+        pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                cells[i] = (uint32_t)(cellY(y[i]) * gridWidth + cellX(x[i]));
+        });
+
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        for (size_t i = 0; i < n; i++)
+            cellStart[cells[i] + 1]++;
+        for (size_t c = 1; c < cellStart.size(); c++)
+            cellStart[c] += cellStart[c - 1];
+
+        // cellStart[c] służy jako kursor zapisu, a potem wraca do początku komórki
+        for (size_t i = 0; i < n; i++)
+        {
+            uint32_t to = cellStart[cells[i]]++;
+            sx[to] = x[i];
+            sy[to] = y[i];
+            sox[to] = ox[i];
+            soy[to] = oy[i];
+        }
+        for (size_t c = cellStart.size() - 1; c > 0; c--)
+            cellStart[c] = cellStart[c - 1];
+        cellStart[0] = 0;
+        x.swap(sx);
+        y.swap(sy);
+        ox.swap(sox);
+        oy.swap(soy);
+    }
+
+    // prędkości nie są sortowane: przed następnym krokiem liczy się je od nowa z pozycji
+    void predict(size_t begin, size_t end, float dt)
+    {
+        size_t i = begin;
+#ifdef SAND_SSE2
+        const __m128 gdt = _mm_set1_ps(GRAVITY * dt);
+        const __m128 dt4 = _mm_set1_ps(dt);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 px = _mm_loadu_ps(&x[i]), py = _mm_loadu_ps(&y[i]);
+            __m128 pvy = _mm_add_ps(_mm_loadu_ps(&vy[i]), gdt);
+            _mm_storeu_ps(&ox[i], px);
+            _mm_storeu_ps(&oy[i], py);
+            px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(&vx[i]), dt4));
+            py = _mm_add_ps(py, _mm_mul_ps(pvy, dt4));
+            constrain4(px, py);
+            _mm_storeu_ps(&x[i], px);
+            _mm_storeu_ps(&y[i], py);
+        }
+#endif
+        for (; i < end; i++)
+        {
+            ox[i] = x[i];
+            oy[i] = y[i];
+            x[i] += vx[i] * dt;
+            y[i] += (vy[i] + GRAVITY * dt) * dt;
+            constrain(x[i], y[i]);
+        }
+    }
+
+    // przesunięcie cząstki i (po sortowaniu) od nachodzących na nią sąsiadów
+    void collide(size_t begin, size_t end)
+    {
+        const float diameter2 = diameter * diameter;
+        const float eps = diameter2 * 1e-6f;
+        const float stacking = STACKING / diameter;
+        // cząstki w tym samym punkcie (np. wciśnięte w róg przez ściany) rozsuwane poziomo,
+        // w kierunku zależnym od kolejności w tablicy
+        const float split = diameter * 0.01f;
+#ifdef SAND_SSE2
+        const __m128 d4 = _mm_set1_ps(diameter), dd4 = _mm_set1_ps(diameter2);
+        const __m128 eps4 = _mm_set1_ps(eps), stacking4 = _mm_set1_ps(stacking);
+        const __m128 half = _mm_set1_ps(0.5f), zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+        const __m128 split4 = _mm_set1_ps(split), lanes0123 = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+#endif
+        for (size_t i = begin; i < end; i++)
+        {
+            float xi = x[i], yi = y[i];
+            int cx = cellX(xi), cy = cellY(yi);
+            int x0 = cx > 0 ? cx - 1 : 0, x1 = cx < gridWidth - 1 ? cx + 1 : cx;
+            float accX = 0.0f, accY = 0.0f, touching = 0.0f;
+#ifdef SAND_SSE2
+            const __m128 xi4 = _mm_set1_ps(xi), yi4 = _mm_set1_ps(yi);
+            __m128 sumX = zero, sumY = zero, hits = zero;
+#endif
+            for (int ny = (cy > 0 ? cy - 1 : 0); ny <= cy + 1 && ny < gridHeight; ny++)
+            {
+                // trzy sąsiednie komórki w wierszu to jeden ciągły zakres
+                size_t j = cellStart[(size_t)ny * gridWidth + x0];
+                size_t last = cellStart[(size_t)ny * gridWidth + x1 + 1];
+#ifdef SAND_SSE2
+                // zakresy mają zwykle po kilka cząstek, więc całe idą czwórkami, a nadmiarowe
+                // pozycje (z innych komórek albo z dopełnienia za końcem tablicy) są maskowane
+                for (; j < last; j += 4)
+                {
+                    __m128 valid = _mm_cmplt_ps(lanes0123, _mm_set1_ps((float)(last - j)));
+                    __m128 ddx = _mm_sub_ps(xi4, _mm_loadu_ps(&x[j]));
+                    __m128 ddy = _mm_sub_ps(yi4, _mm_loadu_ps(&y[j]));
+                    __m128 d2 = _mm_add_ps(_mm_mul_ps(ddx, ddx), _mm_mul_ps(ddy, ddy));
+                    __m128 same = _mm_cmple_ps(d2, eps4);
+                    if (_mm_movemask_ps(same))
+                    {
+                        // znak różnicy indeksów: -1, 0 (ta sama cząstka) albo 1
+                        __m128 order = _mm_sub_ps(_mm_set1_ps((float)i), _mm_add_ps(_mm_set1_ps((float)j), lanes0123));
+                        order = _mm_min_ps(_mm_max_ps(order, _mm_set1_ps(-1.0f)), one);
+                        ddx = _mm_or_ps(_mm_andnot_ps(same, ddx), _mm_and_ps(same, _mm_mul_ps(order, split4)));
+                        d2 = _mm_add_ps(_mm_mul_ps(ddx, ddx), _mm_mul_ps(ddy, ddy));
+                    }
+                    __m128 hit = _mm_and_ps(valid, _mm_and_ps(_mm_cmplt_ps(d2, dd4), _mm_cmpgt_ps(d2, eps4)));
+                    if (_mm_movemask_ps(hit) == 0)
+                        continue;
+                    __m128 inv = _mm_rsqrt_ps(_mm_max_ps(d2, eps4));
+                    __m128 dist = _mm_mul_ps(d2, inv);
+                    __m128 share = _mm_min_ps(_mm_max_ps(_mm_add_ps(half, _mm_mul_ps(ddy, stacking4)), zero), one);
+                    __m128 push = _mm_and_ps(hit, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(d4, dist), inv), share));
+                    sumX = _mm_add_ps(sumX, _mm_mul_ps(ddx, push));
+                    sumY = _mm_add_ps(sumY, _mm_mul_ps(ddy, push));
+                    hits = _mm_add_ps(hits, _mm_and_ps(hit, one));
+                }
+#else
+                for (; j < last; j++)
+                {
+                    float ddx = xi - x[j], ddy = yi - y[j];
+                    float d2 = ddx * ddx + ddy * ddy;
+                    if (d2 <= eps && i != j)
+                    {
+                        ddx = i > j ? split : -split;
+                        d2 = ddx * ddx + ddy * ddy;
+                    }
+                    if (d2 >= diameter2 || d2 <= eps)
+                        continue;
+                    float dist = std::sqrt(d2);
+                    float share = std::min(std::max(0.5f + ddy * stacking, 0.0f), 1.0f);
+                    float push = (diameter - dist) / dist * share;
+                    accX += ddx * push;
+                    accY += ddy * push;
+                    touching += 1.0f;
+                }
+#endif
+            }
+#ifdef SAND_SSE2
+            float lanes[4];
+            _mm_storeu_ps(lanes, sumX);
+            accX = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            _mm_storeu_ps(lanes, sumY);
+            accY = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            _mm_storeu_ps(lanes, hits);
+            touching = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+            // średnia z korekt zamiast sumy: przy wielu sąsiadach suma przestrzela i stos "pompuje" energię
+            float scale = touching > 0.0f ? RELAXATION / touching : 0.0f;
+            dx[i] = accX * scale;
+            dy[i] = accY * scale;
+            contact[i] = touching;
+        }
+    }
+
+    void apply(size_t begin, size_t end)
+    {
+        size_t i = begin;
+#ifdef SAND_SSE2
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 px = _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&dx[i]));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_loadu_ps(&dy[i]));
+            constrain4(px, py);
+            _mm_storeu_ps(&x[i], px);
+            _mm_storeu_ps(&y[i], py);
+        }
+#endif
+        for (; i < end; i++)
+        {
+            x[i] += dx[i];
+            y[i] += dy[i];
+            constrain(x[i], y[i]);
+        }
+    }
+
+    void updateVelocity(size_t begin, size_t end, float invDt)
+    {
+        size_t i = begin;
+        const float free = DAMPING * invDt;
+        const float touching = CONTACT_FRICTION * invDt;
+        // najwyżej jedna średnica na krok, inaczej szybko spadające ziarna wbijają się w stos
+        const float limit = diameter * invDt;
+#ifdef SAND_SSE2
+        const __m128 free4 = _mm_set1_ps(free), touching4 = _mm_set1_ps(touching - free);
+        const __m128 limit4 = _mm_set1_ps(limit);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 inContact = _mm_min_ps(_mm_loadu_ps(&contact[i]), _mm_set1_ps(1.0f));
+            __m128 k = _mm_add_ps(free4, _mm_mul_ps(inContact, touching4));
+            __m128 pvy = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&y[i]), _mm_loadu_ps(&oy[i])), k);
+            __m128 up = _mm_and_ps(_mm_cmpgt_ps(inContact, _mm_setzero_ps()), _mm_cmpgt_ps(pvy, _mm_setzero_ps()));
+            __m128 pvx = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&ox[i])), k);
+            _mm_storeu_ps(&vx[i], _mm_min_ps(_mm_max_ps(pvx, _mm_sub_ps(_mm_setzero_ps(), limit4)), limit4));
+            _mm_storeu_ps(&vy[i], _mm_max_ps(_mm_andnot_ps(up, pvy), _mm_sub_ps(_mm_setzero_ps(), limit4)));
+        }
+#endif
+        for (; i < end; i++)
+        {
+            float k = contact[i] > 0.0f ? touching : free;
+            vx[i] = (x[i] - ox[i]) * k;
+            vy[i] = (y[i] - oy[i]) * k;
+            if (contact[i] > 0.0f && vy[i] > 0.0f)
+                vy[i] = 0.0f;
+            vx[i] = std::min(std::max(vx[i], -limit), limit);
+            vy[i] = std::max(vy[i], -limit);
+        }
+    }
+
+    // ściany klepsydry: dno i góra poziomo, boki zbiegają się do szyjki
+    void constrain(float& px, float& py) const
+    {
+        float top = HALF_HEIGHT - radius;
+        py = std::min(std::max(py, -top), top);
+        float halfWidth = NECK + (HALF_WIDTH / HALF_HEIGHT) * std::fabs(py) - radius;
+        px = std::min(std::max(px, -halfWidth), halfWidth);
+    }
+
+#ifdef SAND_SSE2
+    void constrain4(__m128& px, __m128& py) const
+    {
+        const __m128 top = _mm_set1_ps(HALF_HEIGHT - radius);
+        py = _mm_min_ps(_mm_max_ps(py, _mm_sub_ps(_mm_setzero_ps(), top)), top);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 halfWidth = _mm_add_ps(_mm_set1_ps(NECK - radius),
+            _mm_mul_ps(_mm_set1_ps(HALF_WIDTH / HALF_HEIGHT), _mm_and_ps(py, absMask)));
+        px = _mm_min_ps(_mm_max_ps(px, _mm_sub_ps(_mm_setzero_ps(), halfWidth)), halfWidth);
+    }
+#endif
+};
+
+#endif
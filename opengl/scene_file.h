@@ -0,0 +1,421 @@
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Opis sceny wczytywany z pliku zamiast tablic wierzchołków w kodzie.
+//
+// Postać tekstowa (.scene), jedna deklaracja na linię, '#' zaczyna komentarz:
+//
+//   program  <nazwa> <vertex shader> <fragment shader>
+//   texture  <nazwa> <plik obrazu>
+//   material <nazwa> <program> <tekstura>
+//   chunk                                   // początek kolejnej porcji sceny
+//   mesh     <nazwa> <rozmiary atrybutów, np. 3 2>
+//   v        <wartości wierzchołka>          // powtarzane, aż do "end"
+//   end
+//   instance <mesh> <materiał> <pierwszy wierzchołek> <liczba> [x y z [skala]]
+//
+// Programy, tekstury i materiały są wspólne dla całej sceny; siatki i instancje
+// należą do porcji (chunk) i mogą być wczytywane po kolei, także po pierwszej
+// klatce. Instancja może używać siatek z własnej lub wcześniejszej porcji.
+//
+// Postać binarna (.sceneb, zapisywana przez scenepack) to dokładnie struktury
+// z SceneData: nagłówek z licznikami, tablice rekordów, blok napisów i blok
+// wartości float. Wczytanie to jeden odczyt pliku i kopiowanie całych tablic;
+// nazwy są już zamienione na indeksy, a powtórzone pliki scalone.
+
+namespace scene
+{
+    const uint32_t MAGIC = 0x424E4353; // "SCNB"
+    const uint32_t VERSION = 1;
+    const int MAX_ATTRIBS = 4;
+
+    // napisy są przesunięciami w SceneData::strings (zakończone zerem)
+    struct Program  { uint32_t name, vertexPath, fragmentPath; };
+    struct Texture  { uint32_t name, path; };
+    struct Material { uint32_t name, program, texture; };
+    struct Mesh
+    {
+        uint32_t name;
+        uint32_t firstFloat, vertexCount;
+        uint8_t attribSizes[MAX_ATTRIBS]; // liczba składowych float atrybutów 0..3, 0 = brak
+    };
+    struct Instance
+    {
+        uint32_t mesh, material, first, count;
+        float model[16];
+    };
+    struct Chunk { uint32_t firstMesh, meshCount, firstInstance, instanceCount; };
+
+    struct Header
+    {
+        uint32_t magic, version;
+        uint32_t programs, textures, materials, meshes, instances, chunks;
+        uint32_t stringBytes, floatCount;
+    };
+
+    inline int vertexFloats(const Mesh& m)
+    {
+        int n = 0;
+        for (int i = 0; i < MAX_ATTRIBS; i++)
+            n += m.attribSizes[i];
+        return n;
+    }
+
+    struct SceneData
+    {
+        std::vector<Program> programs;
+        std::vector<Texture> textures;
+        std::vector<Material> materials;
+        std::vector<Mesh> meshes;
+        std::vector<Instance> instances;
+        std::vector<Chunk> chunks;
+        std::vector<char> strings;
+        std::vector<float> floats;
+
+        const char* str(uint32_t offset) const { return &strings[offset]; }
+
+        void clear()
+        {
+            programs.clear(); textures.clear(); materials.clear();
+            meshes.clear(); instances.clear(); chunks.clear();
+            strings.clear(); floats.clear();
+        }
+    };
+
+    inline uint32_t addString(SceneData& scene, const std::string& s)
+    {
+        uint32_t offset = (uint32_t)scene.strings.size();
+        scene.strings.insert(scene.strings.end(), s.begin(), s.end());
+        scene.strings.push_back('\0');
+        return offset;
+    }
+
+    inline bool parseError(const std::string& path, int line, const std::string& message)
+    {
+        std::cout << "BŁĄD::SCENA::" << path << ":" << line << ": " << message << std::endl;
+        return false;
+    }
+
+    // sprawdzenie indeksów i zakresów po wczytaniu sceny w dowolnej postaci
+    inline bool valid(const SceneData& scene)
+    {
+        size_t strings = scene.strings.size();
+        if (strings == 0 || scene.strings.back() != '\0')
+            return false;
+        for (size_t i = 0; i < scene.programs.size(); i++)
+            if (scene.programs[i].vertexPath >= strings || scene.programs[i].fragmentPath >= strings)
+                return false;
+        for (size_t i = 0; i < scene.textures.size(); i++)
+            if (scene.textures[i].path >= strings)
+                return false;
+        for (size_t i = 0; i < scene.materials.size(); i++)
+            if (scene.materials[i].program >= scene.programs.size() || scene.materials[i].texture >= scene.textures.size())
+                return false;
+        for (size_t i = 0; i < scene.meshes.size(); i++)
+        {
+            const Mesh& m = scene.meshes[i];
+            if (vertexFloats(m) == 0 || m.firstFloat + (size_t)m.vertexCount * vertexFloats(m) > scene.floats.size())
+                return false;
+        }
+        for (size_t i = 0; i < scene.instances.size(); i++)
+        {
+            const Instance& inst = scene.instances[i];
+            if (inst.mesh >= scene.meshes.size() || inst.material >= scene.materials.size()
+                || inst.first + (size_t)inst.count > scene.meshes[inst.mesh].vertexCount)
+                return false;
+        }
+        // porcje następują po sobie od zera i razem obejmują wszystkie siatki i instancje
+        // (SceneLoader wczytuje je po kolei i rysuje instancje do końca ostatniej porcji);
+        // instancja może wskazywać tylko siatki z własnej lub wcześniejszej porcji
+        size_t meshEnd = 0, instanceEnd = 0;
+        for (size_t i = 0; i < scene.chunks.size(); i++)
+        {
+            const Chunk& c = scene.chunks[i];
+            if (c.firstMesh != meshEnd || c.firstInstance != instanceEnd)
+                return false;
+            meshEnd += c.meshCount;
+            instanceEnd += c.instanceCount;
+            if (meshEnd > scene.meshes.size() || instanceEnd > scene.instances.size())
+                return false;
+            for (size_t j = c.firstInstance; j < instanceEnd; j++)
+                if (scene.instances[j].mesh >= meshEnd)
+                    return false;
+        }
+        return meshEnd == scene.meshes.size() && instanceEnd == scene.instances.size();
+    }
+
+    // liczba bez znaku; ">>" do typu bez znaku przyjmuje "-1" i zawija ją
+    inline bool readUnsigned(std::istringstream& line, uint32_t& value)
+    {
+        std::string token;
+        if (!(line >> token) || token.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+        unsigned long long v = strtoull(token.c_str(), NULL, 10);
+        if (v > UINT32_MAX)
+            return false;
+        value = (uint32_t)v;
+        return true;
+    }
+
+    // wczytanie postaci tekstowej; nazwy są zamieniane na indeksy tutaj, raz
+    inline bool parseText(const std::string& path, SceneData& scene)
+    {
+        scene.clear();
+        std::ifstream file(path.c_str());
+        if (!file)
+            return parseError(path, 0, "nie można otworzyć pliku");
+
+        std::map<std::string, uint32_t> programs, textures, materials, meshes;
+        std::map<std::string, uint32_t> texturePaths; // ten sam plik = ta sama tekstura
+        Mesh* mesh = NULL;
+        std::string text;
+        int lineNo = 0;
+        while (std::getline(file, text))
+        {
+            lineNo++;
+            size_t hash = text.find('#');
+            if (hash != std::string::npos)
+                text.erase(hash);
+            std::istringstream line(text);
+            std::string keyword;
+            if (!(line >> keyword))
+                continue;
+
+            if (mesh)
+            {
+                if (keyword == "end")
+                {
+                    mesh->vertexCount = (uint32_t)((scene.floats.size() - mesh->firstFloat) / vertexFloats(*mesh));
+                    mesh = NULL;
+                    continue;
+                }
+                if (keyword != "v")
+                    return parseError(path, lineNo, "oczekiwano 'v' lub 'end'");
+                for (int i = 0; i < vertexFloats(*mesh); i++)
+                {
+                    float value;
+                    if (!(line >> value))
+                        return parseError(path, lineNo, "za mało wartości wierzchołka");
+                    scene.floats.push_back(value);
+                }
+                continue;
+            }
+
+            if (scene.chunks.empty() && (keyword == "mesh" || keyword == "instance"))
+                scene.chunks.push_back(Chunk{ 0, 0, 0, 0 });
+
+            if (keyword == "program")
+            {
+                std::string name, vs, fs;
+                if (!(line >> name >> vs >> fs))
+                    return parseError(path, lineNo, "program <nazwa> <vs> <fs>");
+                programs[name] = (uint32_t)scene.programs.size();
+                scene.programs.push_back(Program{ addString(scene, name), addString(scene, vs), addString(scene, fs) });
+            }
+            else if (keyword == "texture")
+            {
+                std::string name, image;
+                if (!(line >> name >> image))
+                    return parseError(path, lineNo, "texture <nazwa> <plik>");
+                std::map<std::string, uint32_t>::iterator same = texturePaths.find(image);
+                if (same != texturePaths.end())
+                {
+                    textures[name] = same->second;
+                    continue;
+                }
+                textures[name] = texturePaths[image] = (uint32_t)scene.textures.size();
+                scene.textures.push_back(Texture{ addString(scene, name), addString(scene, image) });
+            }
+            else if (keyword == "material")
+            {
+                std::string name, program, texture;
+                if (!(line >> name >> program >> texture))
+                    return parseError(path, lineNo, "material <nazwa> <program> <tekstura>");
+                if (!programs.count(program))
+                    return parseError(path, lineNo, "nieznany program " + program);
+                if (!textures.count(texture))
+                    return parseError(path, lineNo, "nieznana tekstura " + texture);
+                materials[name] = (uint32_t)scene.materials.size();
+                scene.materials.push_back(Material{ addString(scene, name), programs[program], textures[texture] });
+            }
+            else if (keyword == "chunk")
+            {
+                uint32_t meshCount = (uint32_t)scene.meshes.size(), instanceCount = (uint32_t)scene.instances.size();
+                if (scene.chunks.empty() || scene.chunks.back().meshCount + scene.chunks.back().instanceCount > 0)
+                    scene.chunks.push_back(Chunk{ meshCount, 0, instanceCount, 0 });
+            }
+            else if (keyword == "mesh")
+            {
+                std::string name;
+                if (!(line >> name))
+                    return parseError(path, lineNo, "mesh <nazwa> <rozmiary atrybutów>");
+                Mesh m;
+                memset(&m, 0, sizeof(m));
+                m.name = addString(scene, name);
+                m.firstFloat = (uint32_t)scene.floats.size();
+                int size, count = 0;
+                while (line >> size)
+                {
+                    if (count == MAX_ATTRIBS || size < 1 || size > 4)
+                        return parseError(path, lineNo, "nieprawidłowe atrybuty");
+                    m.attribSizes[count++] = (uint8_t)size;
+                }
+                if (count == 0)
+                    return parseError(path, lineNo, "siatka bez atrybutów");
+                meshes[name] = (uint32_t)scene.meshes.size();
+                scene.meshes.push_back(m);
+                scene.chunks.back().meshCount++;
+                mesh = &scene.meshes.back();
+            }
+            else if (keyword == "instance")
+            {
+                std::string meshName, materialName;
+                Instance inst;
+                if (!(line >> meshName >> materialName) || !readUnsigned(line, inst.first) || !readUnsigned(line, inst.count))
+                    return parseError(path, lineNo, "instance <mesh> <materiał> <pierwszy> <liczba>");
+                if (!meshes.count(meshName))
+                    return parseError(path, lineNo, "nieznana siatka " + meshName);
+                if (!materials.count(materialName))
+                    return parseError(path, lineNo, "nieznany materiał " + materialName);
+                inst.mesh = meshes[meshName];
+                inst.material = materials[materialName];
+                if (inst.first + (size_t)inst.count > scene.meshes[inst.mesh].vertexCount)
+                    return parseError(path, lineNo, "zakres poza siatką " + meshName);
+                float x = 0.0f, y = 0.0f, z = 0.0f, s = 1.0f;
+                line >> x >> y >> z >> s;
+                const float model[16] = {
+                    s, 0.0f, 0.0f, 0.0f,
+                    0.0f, s, 0.0f, 0.0f,
+                    0.0f, 0.0f, s, 0.0f,
+                    x, y, z, 1.0f,
+                };
+                memcpy(inst.model, model, sizeof(model));
+                scene.instances.push_back(inst);
+                scene.chunks.back().instanceCount++;
+            }
+            else
+                return parseError(path, lineNo, "nieznane słowo " + keyword);
+        }
+        if (mesh)
+            return parseError(path, lineNo, "brak 'end' siatki");
+        if (!valid(scene))
+            return parseError(path, lineNo, "niespójna scena");
+        return true;
+    }
+
+    template <typename T>
+    inline void writeArray(FILE* f, const std::vector<T>& v)
+    {
+        if (!v.empty())
+            fwrite(&v[0], sizeof(T), v.size(), f);
+    }
+
+    inline bool writeBinary(const std::string& path, const SceneData& scene)
+    {
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f)
+        {
+            std::cout << "BŁĄD::SCENA::nie można zapisać " << path << std::endl;
+            return false;
+        }
+        Header h = { MAGIC, VERSION,
+            (uint32_t)scene.programs.size(), (uint32_t)scene.textures.size(),
+            (uint32_t)scene.materials.size(), (uint32_t)scene.meshes.size(),
+            (uint32_t)scene.instances.size(), (uint32_t)scene.chunks.size(),
+            (uint32_t)scene.strings.size(), (uint32_t)scene.floats.size() };
+        fwrite(&h, sizeof(h), 1, f);
+        writeArray(f, scene.programs);
+        writeArray(f, scene.textures);
+        writeArray(f, scene.materials);
+        writeArray(f, scene.meshes);
+        writeArray(f, scene.instances);
+        writeArray(f, scene.chunks);
+        writeArray(f, scene.strings);
+        writeArray(f, scene.floats);
+        bool ok = ferror(f) == 0;
+        fclose(f);
+        return ok;
+    }
+
+    template <typename T>
+    inline bool readArray(const std::vector<char>& data, size_t& offset, uint32_t count, std::vector<T>& v)
+    {
+        size_t bytes = (size_t)count * sizeof(T);
+        if (data.size() - offset < bytes)
+            return false;
+        v.resize(count);
+        if (bytes)
+            memcpy(&v[0], &data[offset], bytes);
+        offset += bytes;
+        return true;
+    }
+
+    // wczytanie postaci binarnej: jeden odczyt całego pliku, potem kopiowanie tablic
+    inline bool readBinary(const std::string& path, SceneData& scene)
+    {
+        scene.clear();
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f)
+        {
+            std::cout << "BŁĄD::SCENA::nie można otworzyć " << path << std::endl;
+            return false;
+        }
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        std::vector<char> data(size > 0 ? (size_t)size : 0);
+        bool ok = !data.empty() && fread(&data[0], 1, data.size(), f) == data.size();
+        fclose(f);
+
+        Header h;
+        ok = ok && data.size() >= sizeof(h);
+        if (ok)
+            memcpy(&h, &data[0], sizeof(h));
+        if (!ok || h.magic != MAGIC || h.version != VERSION)
+        {
+            std::cout << "BŁĄD::SCENA::nieprawidłowy plik " << path << std::endl;
+            return false;
+        }
+        size_t offset = sizeof(h);
+        ok = readArray(data, offset, h.programs, scene.programs)
+            && readArray(data, offset, h.textures, scene.textures)
+            && readArray(data, offset, h.materials, scene.materials)
+            && readArray(data, offset, h.meshes, scene.meshes)
+            && readArray(data, offset, h.instances, scene.instances)
+            && readArray(data, offset, h.chunks, scene.chunks)
+            && readArray(data, offset, h.stringBytes, scene.strings)
+            && readArray(data, offset, h.floatCount, scene.floats);
+        if (!ok || !valid(scene))
+        {
+            std::cout << "BŁĄD::SCENA::uszkodzony plik " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // wybór postaci po nagłówku pliku
+    inline bool load(const std::string& path, SceneData& scene)
+    {
+        uint32_t magic = 0;
+        if (FILE* f = fopen(path.c_str(), "rb"))
+        {
+            if (fread(&magic, sizeof(magic), 1, f) != 1)
+                magic = 0;
+            fclose(f);
+        }
+        return magic == MAGIC ? readBinary(path, scene) : parseText(path, scene);
+    }
+}
+
+#endif
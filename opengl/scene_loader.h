@@ -0,0 +1,451 @@
+#ifndef SCENE_LOADER_H
+#define SCENE_LOADER_H
+
+#include <glad/glad.h>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "scene_file.h"
+#include "shader.h"
+#include "texture_manager.h"
+#include "frame_uniforms.h"
+#include "vertex_format.h"
+#include "gpu_culling.h"
+#include "trace.h"
+
+// Scena z pliku (scene_file.h) na GPU.
+//
+//   SceneLoader scene;
+//   scene.open("hous.scene", textures);  // programy i tekstury, raz
+//     (albo osobno: prepare() bez kontekstu GL, np. w tle, potem createPrograms())
+//   scene.loadNextChunk(textures);       // pierwsza porcja przed pierwszą klatką
+//   ...
+//   if (!scene.complete()) scene.loadNextChunk(textures); // kolejne, po jednej na klatkę
+//   scene.draw(textures, frameUniforms);
+//
+// Siatki "3 2" (pozycja, uv) trafiają na GPU jako CompactTexturedVertex, a "3 2 3 4"
+// (pozycja, uv, normalna, kolor RGBA) jako PackedVertex (vertex_format.h); każdy inny
+// układ zostaje floatami, tak jak w pliku.
+//
+// Na ścieżce CPU każda instancja dostaje macierz model w bloku PerDraw (binding point 0)
+// i własne glDrawArrays. Ścieżka GPU (open(..., true), kontekst 4.3+, wszystkie siatki
+// z pozycją i uv) trzyma siatki w jednym buforze, a instancje odrzuca i rysuje GpuCulling:
+// jedno wywołanie na materiał. Shader wierzchołków jest wtedy wbudowany
+// (GpuCulling::vertexShaderSource()), a z pliku pochodzi tylko fragment shader;
+// frameUniforms nie jest wtedy używany, więc jego beginFrame()/endFrame() można pominąć.
+//
+// Bufory siatek, programy i tekstury są obiektami współdzielonymi, więc pełną scenę
+// można rysować także w innych kontekstach (viewer.cpp): każdy dostaje własne VAO
+// z createDrawContext() i rysuje przez draw(textures, ring, ctx) w swoim wątku.
+class SceneLoader
+{
+public:
+    // stan rysowania w jednym kontekście: VAO siatek (nie są współdzielone między
+    // kontekstami) i alokacje PerDraw bieżącej klatki
+    struct DrawContext
+    {
+        std::vector<GLuint> vertexArrays;
+        std::vector<FrameUniformRing::Allocation> perDraw;
+        bool shared; // kontekst inny niż ten, w którym wczytano scenę
+        DrawContext() : shared(false) {}
+    };
+
+    SceneLoader() : loadedChunks(0), loadedInstances(0), gpuDriven(false), mergedVAO(0), mergedVBO(0) {}
+
+    // wczytanie opisu, kompilacja programów i zlecenie wczytania tekstur
+    bool open(const std::string& path, TextureManager& textures, bool useGpuCulling = false)
+    {
+        return prepare(path, textures) && createPrograms(textures, useGpuCulling);
+    }
+
+    // część bez GL: plik sceny, źródła shaderów i zlecenie dekodowania tekstur;
+    // można ją wykonać na innym wątku, zanim powstanie kontekst
+    bool prepare(const std::string& path, TextureManager& textures)
+    {
+        TRACE_ZONE("wczytanie sceny");
+        if (!scene::load(path, data))
+            return false;
+
+        std::string dir;
+        size_t slash = path.find_last_of("/\\");
+        if (slash != std::string::npos)
+            dir = path.substr(0, slash + 1);
+
+        for (size_t i = 0; i < data.programs.size(); i++)
+        {
+            ShaderSources sources;
+            sources.vertex = readShaderFile(dir + data.str(data.programs[i].vertexPath));
+            sources.fragment = readShaderFile(dir + data.str(data.programs[i].fragmentPath));
+            if (sources.vertex.empty() || sources.fragment.empty())
+                return false;
+            shaderSources.push_back(sources);
+        }
+        for (size_t i = 0; i < data.textures.size(); i++)
+            textureHandles.push_back(textures.load((dir + data.str(data.textures[i].path)).c_str()));
+        meshBuffers.resize(data.meshes.size(), 0);
+        own.vertexArrays.resize(data.meshes.size(), 0);
+        return true;
+    }
+
+    // część GL, po prepare(): wybór ścieżki rysowania i kompilacja programów
+    bool createPrograms(TextureManager& textures, bool useGpuCulling = false)
+    {
+        gpuDriven = useGpuCulling && GpuCulling::available() && allTextured() && initGpuPath(textures);
+        for (size_t i = 0; i < shaderSources.size(); i++)
+        {
+            TRACE_ZONE("kompilacja shaderów");
+            std::string vs = gpuDriven ? GpuCulling::vertexShaderSource() : shaderSources[i].vertex;
+            GLuint program = compileProgram(vs.c_str(), shaderSources[i].fragment.c_str());
+            GLuint block = glGetUniformBlockIndex(program, "PerDraw");
+            if (block != GL_INVALID_INDEX)
+                glUniformBlockBinding(program, block, 0);
+            if (gpuDriven)
+                culling.setupProgram(program);
+            programs.push_back(program);
+        }
+        shaderSources.clear();
+        return true;
+    }
+
+    bool complete() const { return loadedChunks == data.chunks.size(); }
+    size_t chunkCount() const { return data.chunks.size(); }
+    bool isGpuDriven() const { return gpuDriven; }
+
+    // wysłanie na GPU siatek kolejnej porcji; jej instancje są rysowane od następnego draw()
+    bool loadNextChunk(TextureManager& textures)
+    {
+        if (complete())
+            return false;
+        TRACE_ZONE("porcja sceny");
+        const scene::Chunk& chunk = data.chunks[loadedChunks];
+        if (gpuDriven)
+        {
+            uploadChunkGpu(chunk);
+            loadedInstances = chunk.firstInstance + chunk.instanceCount;
+            loadedChunks++;
+            return true;
+        }
+        for (uint32_t m = chunk.firstMesh; m < chunk.firstMesh + chunk.meshCount; m++)
+        {
+            const scene::Mesh& src = data.meshes[m];
+            const float* vertices = src.vertexCount ? &data.floats[src.firstFloat] : NULL;
+            glGenBuffers(1, &meshBuffers[m]);
+            glBindBuffer(GL_ARRAY_BUFFER, meshBuffers[m]);
+
+            size_t bytes;
+            if (isTextured(src))
+            {
+                // pozycja + uv: współrzędne tekstury w half, 16 zamiast 20 bajtów na wierzchołek
+                std::vector<vertex::CompactTexturedVertex> packed(src.vertexCount);
+                for (uint32_t v = 0; v < src.vertexCount; v++)
+                    packed[v] = vertex::CompactTexturedVertex::pack(vertices + v * 5, vertices + v * 5 + 3);
+                bytes = packed.size() * sizeof(packed[0]);
+                glBufferData(GL_ARRAY_BUFFER, bytes, packed.empty() ? NULL : &packed[0], GL_STATIC_DRAW);
+            }
+            else if (isPacked(src))
+            {
+                // pozycja, uv, normalna, kolor: 24 zamiast 48 bajtów na wierzchołek
+                std::vector<vertex::PackedVertex> packed(src.vertexCount);
+                for (uint32_t v = 0; v < src.vertexCount; v++)
+                {
+                    const float* f = vertices + v * 12;
+                    packed[v] = vertex::PackedVertex::pack(f, f + 3, f + 5, f + 8);
+                }
+                bytes = packed.size() * sizeof(packed[0]);
+                glBufferData(GL_ARRAY_BUFFER, bytes, packed.empty() ? NULL : &packed[0], GL_STATIC_DRAW);
+            }
+            else
+            {
+                // dowolny inny układ: same floaty, tak jak w pliku
+                bytes = (size_t)src.vertexCount * scene::vertexFloats(src) * sizeof(float);
+                glBufferData(GL_ARRAY_BUFFER, bytes, vertices, GL_STATIC_DRAW);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            textures.trackBuffer(meshBuffers[m], bytes);
+            own.vertexArrays[m] = createMeshVertexArray(m);
+        }
+        loadedInstances = chunk.firstInstance + chunk.instanceCount;
+        loadedChunks++;
+        return true;
+    }
+
+    // rysowanie wszystkich instancji z wczytanych porcji
+    void draw(TextureManager& textures, FrameUniformRing& frameUniforms)
+    {
+        if (gpuDriven)
+        {
+            drawGpu(textures);
+            return;
+        }
+        drawCpu(textures, frameUniforms, own);
+    }
+
+    // VAO wszystkich siatek w bieżącym kontekście, który współdzieli obiekty z kontekstem
+    // sceny; tylko dla pełnej sceny (complete()) rysowanej przez CPU
+    bool createDrawContext(DrawContext& ctx) const
+    {
+        if (gpuDriven || !complete())
+        {
+            std::cout << "BŁĄD::SCENA::KONTEKST_RYSOWANIA (scena niepełna albo rysowana przez GPU)" << std::endl;
+            return false;
+        }
+        ctx.shared = true;
+        ctx.vertexArrays.resize(meshBuffers.size(), 0);
+        for (uint32_t m = 0; m < meshBuffers.size(); m++)
+            ctx.vertexArrays[m] = createMeshVertexArray(m);
+        return true;
+    }
+
+    // rysowanie w kontekście z createDrawContext(); nie zmienia sceny, a tekstury wiąże
+    // tylko przez TextureManager::bindShared(), więc wiele wątków może rysować naraz,
+    // każdy z własnym ctx i pierścieniem
+    void draw(TextureManager& textures, FrameUniformRing& frameUniforms, DrawContext& ctx) const
+    {
+        drawCpu(textures, frameUniforms, ctx);
+    }
+
+    void destroyDrawContext(DrawContext& ctx) const
+    {
+        if (!ctx.vertexArrays.empty())
+            glDeleteVertexArrays((GLsizei)ctx.vertexArrays.size(), &ctx.vertexArrays[0]);
+        ctx.vertexArrays.clear();
+        ctx.perDraw.clear();
+    }
+
+    void destroy(TextureManager& textures)
+    {
+        for (size_t i = 0; i < meshBuffers.size(); i++)
+        {
+            if (meshBuffers[i])
+                textures.untrackBuffer(meshBuffers[i]);
+            glDeleteBuffers(1, &meshBuffers[i]);
+        }
+        destroyDrawContext(own);
+        for (size_t i = 0; i < programs.size(); i++)
+            glDeleteProgram(programs[i]);
+        if (gpuDriven)
+        {
+            textures.untrackBuffer(mergedVBO);
+            glDeleteVertexArrays(1, &mergedVAO);
+            glDeleteBuffers(1, &mergedVBO);
+            culling.destroy();
+            mergedVAO = mergedVBO = 0;
+            meshBase.clear();
+            gpuDriven = false;
+        }
+        meshBuffers.clear();
+        programs.clear();
+        textureHandles.clear();
+        loadedChunks = 0;
+        loadedInstances = 0;
+    }
+
+private:
+    static bool isTextured(const scene::Mesh& m)
+    {
+        return m.attribSizes[0] == 3 && m.attribSizes[1] == 2 && m.attribSizes[2] == 0;
+    }
+
+    static bool isPacked(const scene::Mesh& m)
+    {
+        return m.attribSizes[0] == 3 && m.attribSizes[1] == 2 && m.attribSizes[2] == 3 && m.attribSizes[3] == 4;
+    }
+
+    bool allTextured() const
+    {
+        for (size_t i = 0; i < data.meshes.size(); i++)
+            if (!isTextured(data.meshes[i]))
+                return false;
+        return true;
+    }
+
+    // VAO siatki m nad jej buforem, w układzie wybranym przy wysyłce
+    GLuint createMeshVertexArray(uint32_t m) const
+    {
+        const scene::Mesh& src = data.meshes[m];
+        GLuint VAO;
+        glGenVertexArrays(1, &VAO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, meshBuffers[m]);
+        if (isTextured(src))
+            vertex::setupVertexAttribs<vertex::CompactTexturedVertex>();
+        else if (isPacked(src))
+            vertex::setupVertexAttribs<vertex::PackedVertex>();
+        else
+        {
+            GLsizei stride = scene::vertexFloats(src) * sizeof(float);
+            size_t offset = 0;
+            for (int a = 0; a < scene::MAX_ATTRIBS && src.attribSizes[a]; a++)
+            {
+                glVertexAttribPointer(a, src.attribSizes[a], GL_FLOAT, GL_FALSE, stride, (void*)offset);
+                glEnableVertexAttribArray(a);
+                offset += src.attribSizes[a] * sizeof(float);
+            }
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return VAO;
+    }
+
+    // ścieżka CPU: macierz model każdej instancji w PerDraw i własne glDrawArrays
+    void drawCpu(TextureManager& textures, FrameUniformRing& frameUniforms, DrawContext& ctx) const
+    {
+        ctx.perDraw.resize(loadedInstances);
+        for (size_t i = 0; i < loadedInstances; i++)
+        {
+            ctx.perDraw[i] = frameUniforms.allocate(sizeof(data.instances[i].model));
+            if (ctx.perDraw[i].ptr)
+                memcpy(ctx.perDraw[i].ptr, data.instances[i].model, sizeof(data.instances[i].model));
+        }
+        frameUniforms.flush();
+
+        uint32_t material = ~0u, mesh = ~0u;
+        for (size_t i = 0; i < loadedInstances; i++)
+        {
+            const scene::Instance& inst = data.instances[i];
+            if (ctx.perDraw[i].ptr == NULL)
+                continue;
+            if (inst.material != material)
+            {
+                material = inst.material;
+                glUseProgram(programs[data.materials[material].program]);
+                TextureManager::Handle texture = textureHandles[data.materials[material].texture];
+                if (ctx.shared)
+                    textures.bindShared(texture);
+                else
+                    textures.bind(texture);
+            }
+            if (inst.mesh != mesh)
+            {
+                mesh = inst.mesh;
+                glBindVertexArray(ctx.vertexArrays[mesh]);
+            }
+            frameUniforms.bind(0, ctx.perDraw[i]);
+            glDrawArrays(GL_TRIANGLES, inst.first, inst.count);
+        }
+    }
+
+    // ścieżka GPU: segment na materiał, wspólny bufor wszystkich siatek
+    bool initGpuPath(TextureManager& textures)
+    {
+        std::vector<uint32_t> perMaterial(data.materials.size(), 0);
+        for (size_t i = 0; i < data.instances.size(); i++)
+            perMaterial[data.instances[i].material]++;
+        if (!culling.init(perMaterial))
+            return false;
+
+        uint32_t vertices = 0;
+        for (size_t i = 0; i < data.meshes.size(); i++)
+        {
+            meshBase.push_back(vertices);
+            vertices += data.meshes[i].vertexCount;
+        }
+        glGenVertexArrays(1, &mergedVAO);
+        glGenBuffers(1, &mergedVBO);
+        glBindVertexArray(mergedVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mergedVBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices * sizeof(vertex::CompactTexturedVertex), NULL, GL_STATIC_DRAW);
+        vertex::setupVertexAttribs<vertex::CompactTexturedVertex>();
+        culling.setupObjectIndex();
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        textures.trackBuffer(mergedVBO, vertices * sizeof(vertex::CompactTexturedVertex));
+        return true;
+    }
+
+    // siatki porcji do wspólnego bufora, instancje z kulami otaczającymi do bufora obiektów
+    void uploadChunkGpu(const scene::Chunk& chunk)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mergedVBO);
+        for (uint32_t m = chunk.firstMesh; m < chunk.firstMesh + chunk.meshCount; m++)
+        {
+            const scene::Mesh& src = data.meshes[m];
+            if (src.vertexCount == 0)
+                continue;
+            const float* vertices = &data.floats[src.firstFloat];
+            std::vector<vertex::CompactTexturedVertex> packed(src.vertexCount);
+            for (uint32_t v = 0; v < src.vertexCount; v++)
+                packed[v] = vertex::CompactTexturedVertex::pack(vertices + v * 5, vertices + v * 5 + 3);
+            glBufferSubData(GL_ARRAY_BUFFER, meshBase[m] * sizeof(packed[0]), packed.size() * sizeof(packed[0]), &packed[0]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        std::vector<GpuCulling::Object> objects(chunk.instanceCount);
+        for (uint32_t i = 0; i < chunk.instanceCount; i++)
+        {
+            const scene::Instance& inst = data.instances[chunk.firstInstance + i];
+            GpuCulling::Object& o = objects[i];
+            memcpy(o.model, inst.model, sizeof(o.model));
+            boundingSphere(data.meshes[inst.mesh], inst.first, inst.count, o.sphere);
+            o.first = meshBase[inst.mesh] + inst.first;
+            o.count = inst.count;
+            o.segment = inst.material;
+            o.pad = 0;
+        }
+        if (!objects.empty())
+            culling.setObjects(chunk.firstInstance, &objects[0], chunk.instanceCount);
+        culling.setObjectCount(chunk.firstInstance + chunk.instanceCount);
+    }
+
+    // środek prostopadłościanu otaczającego i największa odległość od niego
+    void boundingSphere(const scene::Mesh& mesh, uint32_t first, uint32_t count, float* sphere) const
+    {
+        const float* v = &data.floats[mesh.firstFloat] + (size_t)first * 5;
+        float lo[3] = { 0.0f, 0.0f, 0.0f }, hi[3] = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t i = 0; i < count; i++)
+            for (int c = 0; c < 3; c++)
+            {
+                float x = v[i * 5 + c];
+                lo[c] = (i == 0 || x < lo[c]) ? x : lo[c];
+                hi[c] = (i == 0 || x > hi[c]) ? x : hi[c];
+            }
+        float radius2 = 0.0f;
+        for (int c = 0; c < 3; c++)
+            sphere[c] = (lo[c] + hi[c]) * 0.5f;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float d2 = 0.0f;
+            for (int c = 0; c < 3; c++)
+                d2 += (v[i * 5 + c] - sphere[c]) * (v[i * 5 + c] - sphere[c]);
+            radius2 = d2 > radius2 ? d2 : radius2;
+        }
+        sphere[3] = std::sqrt(radius2);
+    }
+
+    // odrzucanie na GPU, potem jedno glMultiDrawArraysIndirect na materiał
+    void drawGpu(TextureManager& textures)
+    {
+        culling.cull();
+        glBindVertexArray(mergedVAO);
+        for (uint32_t m = 0; m < data.materials.size(); m++)
+        {
+            glUseProgram(programs[data.materials[m].program]);
+            textures.bind(textureHandles[data.materials[m].texture]);
+            culling.draw(m);
+        }
+    }
+
+    struct ShaderSources
+    {
+        std::string vertex, fragment;
+    };
+
+
+    scene::SceneData data;
+    std::vector<ShaderSources> shaderSources; // od prepare() do createPrograms()
+    std::vector<GLuint> programs;
+    std::vector<TextureManager::Handle> textureHandles;
+    std::vector<GLuint> meshBuffers;       // VBO siatek, wspólne dla wszystkich kontekstów
+    DrawContext own;                       // VAO kontekstu, w którym wczytano scenę
+    size_t loadedChunks;
+    size_t loadedInstances;
+
+    bool gpuDriven;
+    GpuCulling culling;
+    GLuint mergedVAO, mergedVBO;
+    std::vector<uint32_t> meshBase; // pierwszy wierzchołek siatki we wspólnym buforze
+};
+
+#endif
@@ -0,0 +1,26 @@
+#include <iostream>
+#include "scene_file.h"
+
+// Zamiana opisu sceny z postaci tekstowej na binarną, wczytywaną jednym odczytem.
+//
+//   scenepack hous.scene hous.sceneb
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Użycie: scenepack <scena.scene> <scena.sceneb>" << std::endl;
+        return -1;
+    }
+
+    scene::SceneData data;
+    if (!scene::parseText(argv[1], data))
+        return -1;
+    if (!scene::writeBinary(argv[2], data))
+        return -1;
+
+    std::cout << argv[2] << ": " << data.programs.size() << " programów, "
+        << data.textures.size() << " tekstur, " << data.materials.size() << " materiałów, "
+        << data.meshes.size() << " siatek, " << data.instances.size() << " instancji, "
+        << data.chunks.size() << " porcji" << std::endl;
+    return 0;
+}
@@ -0,0 +1,532 @@
+#ifndef SCENES_H
+#define SCENES_H
+
+#include <glad/glad.h>
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "host.h"
+#include "shader.h"
+#include "vertex_format.h"
+#include "frame_uniforms.h"
+#include "scene_loader.h"
+#include "worker_pool.h"
+#include "sand.h"
+
+// Sceny programów z tego katalogu. Każdy program (triangle.cpp, texture.cpp,
+// hourglass.cpp, hous.cpp) to runScene() z jedną z nich, a viewer.cpp rysuje te same
+// sceny w wielu oknach naraz: część wspólna powstaje raz, w kontekście głównym,
+// a widok tworzy tylko to, czego konteksty nie współdzielą (VAO) i stan klatki.
+
+// kolor jednolity: dwa pomarańczowe trójkąty
+const char* const colorVertexShaderSource = "#version 330 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos.x, aPos.y, aPos.z, 1.0);\n"
+"}\0";
+
+const char* const colorFragmentShaderSource = "#version 330 core\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = vec4(1.0f, 0.5f, 0.2f, 1.0f);\n"
+"}\n\0";
+
+// trójkąt z teksturą
+const char* const texturedVertexShaderSource = "#version 330 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"layout (location = 1) in vec2 aTexCoord;\n"
+"out vec2 TexCoord;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos.x, aPos.y, aPos.z, 1.0);\n"
+"   TexCoord = aTexCoord;\n"
+"}\0";
+
+const char* const texturedFragmentShaderSource = "#version 330 core\n"
+"in vec2 TexCoord;\n"
+"out vec4 FragColor;\n"
+"uniform sampler2D texture1;\n"
+"void main()\n"
+"{\n"
+"   FragColor = texture(texture1, TexCoord);\n"
+"}\n\0";
+
+// ziarna piasku i kontur klepsydry: punkty o zadanej średnicy, kolor z uniformu
+const char* const sandVertexShaderSource = "#version 330 core\n"
+"layout (location = 0) in vec2 aPos;\n"
+"uniform float pointSize;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos, 0.0, 1.0);\n"
+"   gl_PointSize = pointSize;\n"
+"}\0";
+
+const char* const sandFragmentShaderSource = "#version 330 core\n"
+"out vec4 FragColor;\n"
+"uniform vec4 color;\n"
+"void main()\n"
+"{\n"
+"   FragColor = color;\n"
+"}\n\0";
+
+// bufor wierzchołków ze stałymi danymi, liczony w budżecie menedżera
+inline GLuint createVertexBuffer(TextureManager& textures, const void* vertices, size_t bytes)
+{
+    GLuint VBO;
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, bytes, vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    textures.trackBuffer(VBO, bytes);
+    return VBO;
+}
+
+inline void destroyVertexBuffer(TextureManager& textures, GLuint& VBO)
+{
+    if (VBO)
+        textures.untrackBuffer(VBO);
+    glDeleteBuffers(1, &VBO);
+    VBO = 0;
+}
+
+// widok sceny, której cały stan klatki to jedno VAO nad wspólnym buforem
+template <typename V>
+class VertexArrayView : public SceneView
+{
+public:
+    explicit VertexArrayView(GLuint VBO) : VAO(vertex::createVertexArray<V>(VBO)) {}
+    void destroy(TextureManager&) { glDeleteVertexArrays(1, &VAO); }
+protected:
+    GLuint VAO;
+};
+
+// triangle.cpp: dwa pomarańczowe trójkąty
+class TriangleScene : public Scene
+{
+public:
+    TriangleScene() : program(0), VBO(0) {}
+    const char* title() const { return "Triangle"; }
+
+    bool create(TextureManager& textures)
+    {
+        program = compileProgram(colorVertexShaderSource, colorFragmentShaderSource);
+        vertex::PositionVertex vertices[] = {
+            {{ -0.4f, -0.6f, 0.0f }}, // lewy dolny punkt
+            {{  0.4f, -0.6f, 0.0f }}, // prawy dolny punkt
+            {{  0.0f,  0.0f, 0.0f }}, // górny punkt
+
+            {{ -0.4f,  0.6f, 0.0f }}, // lewy górny punkt
+            {{  0.4f,  0.6f, 0.0f }}, // prawy górny punkt
+            {{  0.0f,  0.0f, 0.0f }}  // dolny punkt
+        };
+        VBO = createVertexBuffer(textures, vertices, sizeof(vertices));
+        return program != 0;
+    }
+
+    SceneView* createView(TextureManager&, bool) { return new View(*this); }
+
+    void destroy(TextureManager& textures)
+    {
+        destroyVertexBuffer(textures, VBO);
+        glDeleteProgram(program);
+        program = 0;
+    }
+
+private:
+    class View : public VertexArrayView<vertex::PositionVertex>
+    {
+    public:
+        explicit View(const TriangleScene& scene) : VertexArrayView(scene.VBO), scene(scene) {}
+        void draw(TextureManager&)
+        {
+            glUseProgram(scene.program);
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+    private:
+        const TriangleScene& scene;
+    };
+
+    GLuint program, VBO;
+};
+
+// texture.cpp: trójkąt z teksturą ściany
+class TextureScene : public Scene
+{
+public:
+    TextureScene() : program(0), VBO(0), wall(0) {}
+    const char* title() const { return "Texture"; }
+
+    // dekodowanie JPEG w tle, jeszcze bez kontekstu
+    bool prepare(TextureManager& textures)
+    {
+        wall = textures.load("wall.jpg");
+        return true;
+    }
+
+    bool create(TextureManager& textures)
+    {
+        program = compileProgram(texturedVertexShaderSource, texturedFragmentShaderSource);
+        vertex::TexturedVertex vertices[] = {
+            // Pozycje                  // Koordynaty tekstury
+            {{ -0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f }}, // Lewy dolny
+            {{  0.5f, -0.5f, 0.0f }, { 1.0f, 0.0f }}, // Prawy dolny
+            {{  0.0f,  0.5f, 0.0f }, { 0.5f, 1.0f }}  // Górny
+        };
+        VBO = createVertexBuffer(textures, vertices, sizeof(vertices));
+        return program != 0;
+    }
+
+    SceneView* createView(TextureManager&, bool shared) { return new View(*this, shared); }
+
+    void destroy(TextureManager& textures)
+    {
+        destroyVertexBuffer(textures, VBO);
+        glDeleteProgram(program);
+        program = 0;
+    }
+
+private:
+    class View : public VertexArrayView<vertex::TexturedVertex>
+    {
+    public:
+        View(const TextureScene& scene, bool shared) : VertexArrayView(scene.VBO), scene(scene), shared(shared) {}
+        void draw(TextureManager& textures)
+        {
+            if (shared)
+                textures.bindShared(scene.wall);
+            else
+                textures.bind(scene.wall);
+            glUseProgram(scene.program);
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+    private:
+        const TextureScene& scene;
+        bool shared;
+    };
+
+    GLuint program, VBO;
+    TextureManager::Handle wall;
+};
+
+// hous.cpp: scena z pliku (scene_file.h) przez SceneLoader. GPU_CULLING=1 prosi
+// o kontekst 4.3 i rysowanie sterowane przez GPU (gpu_culling.h); bez niego albo
+// bez 4.3 zostaje ścieżka CPU
+class HouseScene : public Scene
+{
+public:
+    explicit HouseScene(const std::string& path) : path(path), gpuCulling(false)
+    {
+        const char* cullingEnv = getenv("GPU_CULLING");
+        gpuCulling = cullingEnv && atoi(cullingEnv) != 0;
+    }
+    const char* title() const { return "House"; }
+    int glVersion() const { return gpuCulling ? 43 : 33; }
+
+    // plik sceny, źródła shaderów i zlecenie tekstur bez kontekstu
+    bool prepare(TextureManager& textures) { return loader.prepare(path, textures); }
+
+    // programy i pierwsza porcja siatek przed pierwszą klatką
+    bool create(TextureManager& textures)
+    {
+        if (!loader.createPrograms(textures, gpuCulling))
+            return false;
+        if (gpuCulling && !loader.isGpuDriven())
+            std::cout << "Odrzucanie na GPU niedostępne, rysowanie przez CPU" << std::endl;
+        loader.loadNextChunk(textures);
+        return true;
+    }
+
+    // pozostałe porcje po jednej na wywołanie
+    bool complete() const { return loader.complete(); }
+    void loadMore(TextureManager& textures) { loader.loadNextChunk(textures); }
+
+    SceneView* createView(TextureManager& textures, bool shared)
+    {
+        View* view = new View(loader, shared);
+        if (!view->init(textures))
+        {
+            delete view;
+            return NULL;
+        }
+        return view;
+    }
+
+    void destroy(TextureManager& textures) { loader.destroy(textures); }
+
+private:
+    // widok z własnym pierścieniem uniformów: dane wszystkich rysowań z jednej klatki
+    class View : public SceneView
+    {
+    public:
+        View(SceneLoader& loader, bool shared) : loader(loader), shared(shared) {}
+
+        bool init(TextureManager& textures)
+        {
+            if (!frameUniforms.init(64 * 1024))
+                return false;
+            if (shared)
+                return loader.createDrawContext(ctx);
+            textures.trackBuffer(frameUniforms.buffer(), frameUniforms.sizeBytes());
+            return true;
+        }
+
+        void draw(TextureManager& textures)
+        {
+            // dane per-rysowanie zapisywane najpierw, potem jeden flush na klatkę;
+            // ścieżka GPU nie używa pierścienia, więc nie jest on wtedy mapowany
+            bool perDrawRing = !loader.isGpuDriven();
+            if (perDrawRing)
+                frameUniforms.beginFrame();
+            if (shared)
+                loader.draw(textures, frameUniforms, ctx);
+            else
+                loader.draw(textures, frameUniforms);
+            if (perDrawRing)
+                frameUniforms.endFrame();
+        }
+
+        void destroy(TextureManager& textures)
+        {
+            if (shared)
+                loader.destroyDrawContext(ctx);
+            else
+                textures.untrackBuffer(frameUniforms.buffer());
+            frameUniforms.destroy();
+        }
+
+    private:
+        SceneLoader& loader;
+        bool shared;
+        FrameUniformRing frameUniforms;
+        SceneLoader::DrawContext ctx;
+    };
+
+    std::string path;
+    bool gpuCulling;
+    SceneLoader loader;
+};
+
+// liczba ziaren piasku (SAND_PARTICLES nadpisuje), liczba wątków symulacji
+// razem z głównym (SAND_THREADS nadpisuje, 0 = wszystkie rdzenie)
+const size_t SAND_PARTICLES = 200000;
+const unsigned int SAND_THREADS = 0;
+// kroki symulacji na klatkę i ich długość
+const int SAND_SUBSTEPS = 2;
+const float SAND_STEP_SECONDS = 1.0f / 120.0f;
+
+// hourglass.cpp: piasek z symulacji (sand.h) w konturze klepsydry
+class HourglassScene : public Scene
+{
+public:
+    HourglassScene() : program(0), glassVBO(0), colorLocation(-1), pointSizeLocation(-1) {}
+    const char* title() const { return "Hourglass"; }
+
+    // rozmieszczenie ziaren i pula wątków pierwszego widoku powstają w tle,
+    // równolegle z tworzeniem okna i kompilacją shaderów
+    bool prepare(TextureManager&)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        createSimulation(preparedWorkers, preparedSimulation);
+        return true;
+    }
+
+    // program i kontur klepsydry: jedna łamana zamknięta
+    bool create(TextureManager& textures)
+    {
+        program = compileProgram(sandVertexShaderSource, sandFragmentShaderSource);
+        colorLocation = glGetUniformLocation(program, "color");
+        pointSizeLocation = glGetUniformLocation(program, "pointSize");
+
+        const float H = SandSimulation::HALF_HEIGHT, W = SandSimulation::HALF_WIDTH, N = SandSimulation::NECK;
+        vertex::Position2DVertex glass[] = {
+            {{ -W,  H }}, // lewy górny
+            {{  W,  H }}, // prawy górny
+            {{  N, 0.0f }},
+            {{  W, -H }}, // prawy dolny
+            {{ -W, -H }}, // lewy dolny
+            {{ -N, 0.0f }}
+        };
+        glassVBO = createVertexBuffer(textures, glass, sizeof(glass));
+        return program != 0;
+    }
+
+    // każdy widok ma własną symulację; pierwszy przejmuje tę z prepare()
+    SceneView* createView(TextureManager&, bool)
+    {
+        std::unique_ptr<WorkerPool> workers;
+        std::unique_ptr<SandSimulation> simulation;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            workers.swap(preparedWorkers);
+            simulation.swap(preparedSimulation);
+        }
+        if (!simulation)
+            createSimulation(workers, simulation);
+        View* view = new View(*this, workers, simulation);
+        if (!view->init())
+        {
+            delete view;
+            return NULL;
+        }
+        return view;
+    }
+
+    void destroy(TextureManager& textures)
+    {
+        destroyVertexBuffer(textures, glassVBO);
+        glDeleteProgram(program);
+        program = 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        preparedSimulation.reset();
+        preparedWorkers.reset();
+    }
+
+private:
+    static void createSimulation(std::unique_ptr<WorkerPool>& workers, std::unique_ptr<SandSimulation>& simulation)
+    {
+        size_t particles = SAND_PARTICLES;
+        if (const char* env = getenv("SAND_PARTICLES"))
+            particles = strtoul(env, NULL, 10);
+        unsigned int threads = SAND_THREADS;
+        if (const char* env = getenv("SAND_THREADS"))
+            threads = (unsigned int)strtoul(env, NULL, 10);
+        workers.reset(new WorkerPool(threads));
+        simulation.reset(new SandSimulation(particles, *workers));
+    }
+
+    // Pozycje ziaren trafiają co klatkę do bufora pierścieniowego z frame_uniforms.h,
+    // użytego tu jako źródło wierzchołków: na GL 4.4+ zmapowanego na stałe, na 3.3
+    // mapowanego bez synchronizacji; fence pilnuje regionów, które GPU jeszcze czyta
+    class View : public SceneView
+    {
+    public:
+        View(const HourglassScene& scene, std::unique_ptr<WorkerPool>& pool, std::unique_ptr<SandSimulation>& sim)
+            : scene(scene), sandBytes(0), sandVAO(0), glassVAO(0), simMs(0.0), writeMs(0.0), statFrames(0)
+        {
+            workers.swap(pool);
+            simulation.swap(sim);
+        }
+
+        bool init()
+        {
+            sandBytes = (GLsizeiptr)(simulation->count() * sizeof(vertex::Position2DVertex)); // writePositions: pary x, y
+            if (!sandStream.init(sandBytes))
+                return false;
+            // atrybuty ustawiane co klatkę, bo region bufora zmienia się z klatki na klatkę
+            glGenVertexArrays(1, &sandVAO);
+            glassVAO = vertex::createVertexArray<vertex::Position2DVertex>(scene.glassVBO);
+            glEnable(GL_PROGRAM_POINT_SIZE);
+            std::cout << "Piasek: " << simulation->count() << " ziaren, " << workers->size() << " wątków, "
+                      << SandSimulation::simdName() << std::endl;
+            statStart = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        // symulacja przed czekaniem na GPU
+        void update()
+        {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < SAND_SUBSTEPS; i++)
+                simulation->step(SAND_STEP_SECONDS);
+            simMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        void draw(TextureManager&)
+        {
+            SandSimulation& sand = *simulation;
+
+            // zapis pozycji prosto do zmapowanego bufora
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            sandStream.beginFrame();
+            FrameUniformRing::Allocation positions = sandStream.allocate(sandBytes);
+            if (positions.ptr)
+                sand.writePositions((float*)positions.ptr);
+            sandStream.flush();
+            writeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+            glUseProgram(scene.program);
+            if (positions.ptr)
+            {
+                // średnica ziarna w pikselach przy obecnej wysokości okna
+                int viewport[4];
+                glGetIntegerv(GL_VIEWPORT, viewport);
+                float pointSize = sand.particleRadius() * viewport[3];
+                glUniform1f(scene.pointSizeLocation, pointSize > 1.0f ? pointSize : 1.0f);
+                glUniform4f(scene.colorLocation, 1.0f, 0.5f, 0.2f, 1.0f);
+                glBindVertexArray(sandVAO);
+                // ten sam format co kontur, od początku regionu tej klatki w pierścieniu
+                glBindBuffer(GL_ARRAY_BUFFER, sandStream.buffer());
+                vertex::setupVertexAttribs<vertex::Position2DVertex>((size_t)positions.offset);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                glDrawArrays(GL_POINTS, 0, (GLsizei)sand.count());
+            }
+            sandStream.endFrame();
+
+            // rysowanie konturu klepsydry
+            glUniform4f(scene.colorLocation, 0.9f, 0.9f, 0.9f, 1.0f);
+            glBindVertexArray(glassVAO);
+            glDrawArrays(GL_LINE_LOOP, 0, 6);
+
+            // statystyki co sekundę: czas symulacji i przepustowość zapisu do bufora
+            statFrames++;
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - statStart).count();
+            if (elapsed >= 1.0)
+            {
+                double megabytes = (double)sandBytes * statFrames / (1024.0 * 1024.0);
+                std::cout << statFrames / elapsed << " FPS, symulacja " << simMs / statFrames << " ms/klatkę, zapis "
+                          << writeMs / statFrames << " ms/klatkę (" << megabytes / elapsed << " MB/s)" << std::endl;
+                simMs = writeMs = 0.0;
+                statFrames = 0;
+                statStart = std::chrono::steady_clock::now();
+            }
+        }
+
+        void destroy(TextureManager&)
+        {
+            glDeleteVertexArrays(1, &glassVAO);
+            glDeleteVertexArrays(1, &sandVAO);
+            sandStream.destroy();
+        }
+
+    private:
+        const HourglassScene& scene;
+        std::unique_ptr<WorkerPool> workers;
+        std::unique_ptr<SandSimulation> simulation;
+        FrameUniformRing sandStream;
+        GLsizeiptr sandBytes;
+        GLuint sandVAO, glassVAO;
+        double simMs, writeMs;
+        int statFrames;
+        std::chrono::steady_clock::time_point statStart;
+    };
+
+    GLuint program, glassVBO;
+    int colorLocation, pointSizeLocation;
+    // symulacja z prepare(), czekająca na pierwszy widok
+    std::mutex mutex;
+    std::unique_ptr<WorkerPool> preparedWorkers;
+    std::unique_ptr<SandSimulation> preparedSimulation;
+};
+
+// scena po nazwie programu, z którego pochodzi; NULL dla nieznanej nazwy
+inline Scene* createScene(const std::string& name)
+{
+    if (name == "triangle")
+        return new TriangleScene();
+    if (name == "hourglass")
+        return new HourglassScene();
+    if (name == "texture")
+        return new TextureScene();
+    if (name == "hous")
+        return new HouseScene("hous.scene");
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// kompilacja i łączenie programu shaderów, z tymi samymi komunikatami błędów co w demach
+inline unsigned int compileProgram(const char* vertexSource, const char* fragmentSource)
+{
+    int success;
+    char infoLog[512];
+    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSource, NULL);
+    glCompileShader(vertexShader);
+    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+        std::cout << "BŁĄD::SHADER::VERTEX::KOMPILACJA_NIEUDANA\n" << infoLog << std::endl;
+    }
+    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+    glCompileShader(fragmentShader);
+    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+        std::cout << "BŁĄD::SHADER::FRAGMENT::KOMPILACJA_NIEUDANA\n" << infoLog << std::endl;
+    }
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "BŁĄD::SHADER::PROGRAM::LINKING_NIEUDANY\n" << infoLog << std::endl;
+    }
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return program;
+}
+
+// wczytanie źródła shadera z pliku; pusty napis przy błędzie
+inline std::string readShaderFile(const std::string& path)
+{
+    std::string source;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f)
+    {
+        std::cout << "BŁĄD::SHADER::PLIK_NIE_WCZYTANY: " << path << std::endl;
+        return source;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    source.resize(size > 0 ? (size_t)size : 0);
+    if (size > 0 && fread(&source[0], 1, source.size(), f) != source.size())
+        source.clear();
+    fclose(f);
+    return source;
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "trace.h"
+
+// Start programu jako graf zależności zamiast ciągu kroków.
+//
+//   StartupGraph startup;
+//   StartupGraph::Task file = startup.add("plik sceny", StartupGraph::WORKER, [&] { ...; return true; });
+//   StartupGraph::Task context = startup.add("okno i kontekst", StartupGraph::MAIN, [&] { ... });
+//   StartupGraph::Task programs = startup.add("programy", StartupGraph::MAIN, [&] { ... }, { file, context });
+//   startup.start();            // zadania WORKER ruszają od razu, na wątkach w tle
+//   if (!startup.run(programs)) // zadania MAIN na wątku wywołującym (kontekst GL), aż do `programs`
+//       return -1;
+//   ... pierwsza klatka ...
+//   startup.mark("pierwsza klatka");
+//   startup.printTimings();
+//
+// Zadanie rusza, gdy wszystkie jego zależności się skończą: wczytywanie plików
+// i dekodowanie idą w tle jeszcze przed utworzeniem kontekstu, a zadania GL są
+// wykonywane zaraz, gdy kontekst i ich dane są gotowe. Zadanie zwraca false przy
+// błędzie; zależne od niego zadania są wtedy pomijane, a run() zwraca false.
+// Zadania trzeba dodać przed start().
+class StartupGraph
+{
+public:
+    enum Where { WORKER, MAIN };
+    typedef size_t Task;
+
+    explicit StartupGraph(unsigned int workers = 2) : origin(std::chrono::steady_clock::now()),
+        workerCount(workers > 0 ? workers : 1), quit(false)
+    {
+    }
+
+    ~StartupGraph()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        changed.notify_all();
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+    }
+
+    Task add(const char* name, Where where, const std::function<bool()>& fn, std::initializer_list<Task> deps = {})
+    {
+        Node node;
+        node.name = name;
+        node.where = where;
+        node.fn = fn;
+        node.waiting = 0;
+        for (Task dep : deps)
+        {
+            nodes[dep].dependents.push_back(nodes.size());
+            node.waiting++;
+        }
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Task t = 0; t < nodes.size(); t++)
+            if (nodes[t].waiting == 0)
+                enqueue(t);
+        for (unsigned int i = 0; i < workerCount; i++)
+            threads.push_back(std::thread(&StartupGraph::runWorker, this));
+    }
+
+    // wykonuje zadania MAIN, aż `target` się skończy; false, jeśli ono albo jego zależność zawiodło
+    bool run(Task target)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            if (nodes[target].state == DONE || nodes[target].state == FAILED)
+                return nodes[target].state == DONE;
+            if (mainQueue.empty())
+            {
+                changed.wait(lock);
+                continue;
+            }
+            Task t = mainQueue.front();
+            mainQueue.pop_front();
+            execute(t, lock);
+        }
+    }
+
+    // chwila bez czasu trwania, np. pierwsza klatka albo komplet tekstur
+    void mark(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Mark m = { name, elapsedMs() };
+        marks.push_back(m);
+    }
+
+    // czasy zadań i znaczników w ms od utworzenia grafu, w kolejności startu
+    void printTimings()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Task> order;
+        for (Task t = 0; t < nodes.size(); t++)
+            if (nodes[t].state == DONE || nodes[t].state == FAILED)
+                order.push_back(t);
+        for (size_t i = 1; i < order.size(); i++)
+            for (size_t j = i; j > 0 && nodes[order[j]].begin < nodes[order[j - 1]].begin; j--)
+                std::swap(order[j], order[j - 1]);
+
+        std::cout << "Start (ms od uruchomienia):" << std::endl;
+        char line[160];
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            const Node& n = nodes[order[i]];
+            snprintf(line, sizeof(line), " %8.1f - %8.1f  (%7.1f)  %s%s", n.begin, n.end, n.end - n.begin,
+                n.where == MAIN ? "główny" : "w tle", n.state == FAILED ? ", BŁĄD" : "");
+            std::cout << "  " << padded(n.name) << line << std::endl;
+        }
+        for (size_t i = 0; i < marks.size(); i++)
+        {
+            snprintf(line, sizeof(line), " %8.1f", marks[i].at);
+            std::cout << "  " << padded(marks[i].name) << line << std::endl;
+        }
+    }
+
+private:
+    enum State { PENDING, QUEUED, RUNNING, DONE, FAILED };
+    static const size_t NAME_WIDTH = 28;
+
+    struct Node
+    {
+        const char* name;
+        Where where;
+        std::function<bool()> fn;
+        std::vector<Task> dependents;
+        unsigned int waiting; // zależności, które jeszcze się nie skończyły
+        State state;
+        double begin, end;
+
+        Node() : name(""), where(MAIN), waiting(0), state(PENDING), begin(0.0), end(0.0) {}
+    };
+
+    struct Mark
+    {
+        const char* name;
+        double at;
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    unsigned int workerCount;
+    std::vector<Node> nodes;
+    std::vector<Mark> marks;
+    std::deque<Task> workerQueue, mainQueue;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool quit;
+
+    double elapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    // nazwa dopełniona spacjami do stałej liczby znaków (nie bajtów: nazwy są w UTF-8)
+    static std::string padded(const char* name)
+    {
+        std::string s = name;
+        size_t chars = 0;
+        for (size_t i = 0; i < s.size(); i++)
+            if (((unsigned char)s[i] & 0xC0) != 0x80)
+                chars++;
+        if (chars < NAME_WIDTH)
+            s.append(NAME_WIDTH - chars, ' ');
+        return s;
+    }
+
+    void enqueue(Task t)
+    {
+        nodes[t].state = QUEUED;
+        (nodes[t].where == MAIN ? mainQueue : workerQueue).push_back(t);
+    }
+
+    // wykonanie zadania bez blokady i rozliczenie zależnych; wołane z zablokowanym mutexem
+    void execute(Task t, std::unique_lock<std::mutex>& lock)
+    {
+        Node& node = nodes[t];
+        node.state = RUNNING;
+        node.begin = elapsedMs();
+        lock.unlock();
+        bool ok;
+        {
+            TRACE_ZONE(node.name);
+            ok = node.fn();
+        }
+        lock.lock();
+        node.end = elapsedMs();
+        if (ok)
+        {
+            node.state = DONE;
+            for (size_t i = 0; i < node.dependents.size(); i++)
+                if (--nodes[node.dependents[i]].waiting == 0)
+                    enqueue(node.dependents[i]);
+        }
+        else
+        {
+            std::cout << "BŁĄD::START::" << node.name << std::endl;
+            fail(t);
+        }
+        changed.notify_all();
+    }
+
+    // zadanie i wszystkie od niego zależne kończą się błędem
+    void fail(Task t)
+    {
+        nodes[t].state = FAILED;
+        for (size_t i = 0; i < nodes[t].dependents.size(); i++)
+        {
+            Node& dependent = nodes[nodes[t].dependents[i]];
+            if (dependent.state == PENDING)
+            {
+                dependent.begin = dependent.end = nodes[t].end;
+                fail(nodes[t].dependents[i]);
+            }
+        }
+    }
+
+    void runWorker()
+    {
+        TRACE_THREAD_NAME("StartupGraph");
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            changed.wait(lock, [this] { return quit || !workerQueue.empty(); });
+            if (quit)
+                return;
+            Task t = workerQueue.front();
+            workerQueue.pop_front();
+            execute(t, lock);
+        }
+    }
+};
+
+#endif
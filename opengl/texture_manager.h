@@ -0,0 +1,359 @@
+#ifndef TEXTURE_MANAGER_H
+#define TEXTURE_MANAGER_H
+
+#include <glad/glad.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "mip_loader.h"
+
+// Menedżer tekstur z budżetem pamięci GPU i strumieniowaniem mipmap.
+//
+// Tekstury są dekodowane w tle (MipLoader), a update() wysyła je na GPU od
+// najmniejszego poziomu mipmap w górę, w ramach budżetu bajtów na klatkę.
+// GL_TEXTURE_BASE_LEVEL ogranicza próbkowanie do poziomów, które już dotarły
+// (LOD jest liczony względem poziomu bazowego, więc osobny MIN_LOD nie jest
+// potrzebny). Tekstura jest widoczna od razu w niskiej rozdzielczości, a duże
+// poziomy są wysyłane pasami wierszy, żeby nie było skoków czasu klatki.
+//
+// load() nie używa GL: obiekt tekstury powstaje w update(), gdy dotrze pierwszy
+// zdekodowany obraz. Tekstury można więc zlecić jeszcze przed utworzeniem kontekstu
+// (także z innego wątku, dopóki główny nie woła update()), a dekodowanie idzie
+// równolegle z tworzeniem okna.
+//
+// Zlicza bajty każdej tekstury (razem z poziomami mipmap) i każdego zarejestrowanego
+// bufora. Gdy suma przekroczy budżet, najdawniej używane tekstury są najpierw
+// zdejmowane do niskich poziomów mipmap (podnosimy poziom bazowy i zwalniamy
+// wyższe poziomy), a potem usuwane całkiem. Tekstura jest doczytywana z pliku
+// automatycznie przy następnym bind().
+class TextureManager
+{
+public:
+    typedef unsigned int Handle;
+
+    // poniżej tego rozmiaru (dłuższy bok w pikselach) tekstura nie jest już zmniejszana, tylko usuwana
+    static const int LOW_MIP_SIZE = 64;
+
+    explicit TextureManager(size_t budgetBytes) : budget(budgetBytes), used(0), frame(0) {}
+
+    // rejestracja tekstury i zlecenie wczytania w tle; zwraca od razu, nie wymaga kontekstu GL.
+    // Ten sam plik z kilku scen to jedna tekstura i jeden uchwyt
+    Handle load(const char* path)
+    {
+        std::map<std::string, Handle>::iterator it = byPath.find(path);
+        if (it != byPath.end())
+            return it->second;
+        Entry e;
+        e.path = path;
+        textures.push_back(e);
+        Handle h = (Handle)textures.size();
+        byPath[path] = h;
+        stream(h);
+        textures.back().lastUse = frame;
+        return h;
+    }
+
+    // powiązanie tekstury z bieżącą jednostką; zleca doczytanie, jeśli została zdjęta z GPU
+    GLuint bind(Handle h)
+    {
+        if (h == 0 || h > textures.size())
+            return 0;
+        Entry& e = textures[h - 1];
+        if (!e.streaming && !e.failed && (e.id == 0 || e.baseLevel > 0))
+            stream(h);
+        e.lastUse = frame;
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        return e.id;
+    }
+
+    // sam identyfikator tekstury, bez wiązania i doczytywania; dla innych kontekstów
+    // współdzielących obiekty, gdy menedżer już nic nie zmienia (idle(), bez endFrame())
+    GLuint id(Handle h) const
+    {
+        if (h == 0 || h > textures.size())
+            return 0;
+        return textures[h - 1].id;
+    }
+
+    // powiązanie przez id(): bez doczytywania i bez śledzenia użycia, więc może je
+    // wołać wiele kontekstów naraz, dopóki menedżer nic nie zmienia
+    GLuint bindShared(Handle h) const
+    {
+        GLuint texture = id(h);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return texture;
+    }
+
+    // wywoływane raz na klatkę, przed rysowaniem: wysyłka kolejnych poziomów mipmap,
+    // najwyżej uploadBudget bajtów (plus co najwyżej jeden wiersz, żeby zawsze był postęp)
+    void update(size_t uploadBudget)
+    {
+        TRACE_ZONE("wysyłka tekstur");
+        std::vector<MipLoader::Result> ready = loader.poll();
+        for (size_t i = 0; i < ready.size(); i++)
+        {
+            Entry& e = textures[ready[i].id - 1];
+            if (!e.streaming)
+                continue;
+            if (!ready[i].chain)
+            {
+                std::cout << "Błąd wczytywania tekstury: " << e.path << std::endl;
+                e.streaming = false;
+                e.failed = true;
+                continue;
+            }
+            e.chain = ready[i].chain;
+            if (e.levels == 0)
+            {
+                e.width = e.chain->levels[0].width;
+                e.height = e.chain->levels[0].height;
+                e.levels = (int)e.chain->levels.size();
+                e.baseLevel = e.allocLevel = e.levels;
+            }
+            if (e.id == 0)
+                createTexture(e);
+            glBindTexture(GL_TEXTURE_2D, e.id);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, e.levels - 1);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (size_t i = 0; i < textures.size() && uploadBudget > 0; i++)
+        {
+            Entry& e = textures[i];
+            if (e.streaming && e.chain)
+                uploadBudget = uploadLevels(e, uploadBudget);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    // bufory nie są usuwane, ale wliczają się do budżetu
+    void trackBuffer(GLuint buffer, size_t bytes)
+    {
+        untrackBuffer(buffer);
+        buffers[buffer] = bytes;
+        used += bytes;
+    }
+
+    void untrackBuffer(GLuint buffer)
+    {
+        std::map<GLuint, size_t>::iterator it = buffers.find(buffer);
+        if (it == buffers.end())
+            return;
+        used -= it->second;
+        buffers.erase(it);
+    }
+
+    // wywoływane raz na klatkę, po rysowaniu: egzekwowanie budżetu
+    void endFrame()
+    {
+        while (used > budget)
+        {
+            Entry* victim = leastRecentlyUsed();
+            if (victim == NULL)
+                break;
+            if (levelSize(*victim, victim->baseLevel + 1) >= LOW_MIP_SIZE)
+                demote(*victim);
+            else
+                evict(*victim);
+        }
+        frame++;
+    }
+
+    size_t usedBytes() const { return used; }
+    size_t budgetBytes() const { return budget; }
+
+    // czy wszystkie tekstury są już w pełnej rozdzielczości
+    bool idle() const
+    {
+        for (size_t i = 0; i < textures.size(); i++)
+            if (textures[i].streaming)
+                return false;
+        return true;
+    }
+
+    void printStats() const
+    {
+        std::cout << "GPU: " << used / 1024 << " KB / " << budget / 1024 << " KB" << std::endl;
+        for (size_t i = 0; i < textures.size(); i++)
+        {
+            const Entry& e = textures[i];
+            std::cout << "  " << e.path << ": " << e.bytes / 1024 << " KB";
+            if (e.id == 0)
+                std::cout << " (usunięta)";
+            else if (e.baseLevel > 0)
+                std::cout << " (od poziomu " << e.baseLevel << ")";
+            std::cout << std::endl;
+        }
+    }
+
+    void destroy()
+    {
+        for (size_t i = 0; i < textures.size(); i++)
+            evict(textures[i]);
+        buffers.clear();
+        used = 0;
+    }
+
+private:
+    struct Entry
+    {
+        std::string path;
+        GLuint id;
+        int width, height;
+        int levels;     // 0 dopóki obraz nie został zdekodowany po raz pierwszy
+        int baseLevel;  // najniższy kompletny poziom na GPU (levels = brak poziomów)
+        int allocLevel; // najniższy poziom z zaalokowaną pamięcią
+        int rowsDone;   // wiersze poziomu allocLevel wysłane do tej pory
+        bool streaming;
+        bool failed;
+        std::shared_ptr<MipChain> chain;
+        size_t bytes;
+        unsigned long lastUse;
+
+        Entry() : id(0), width(0), height(0), levels(0), baseLevel(0), allocLevel(0), rowsDone(0),
+            streaming(false), failed(false), bytes(0), lastUse(0) {}
+    };
+
+    size_t budget;
+    size_t used;
+    unsigned long frame;
+    std::vector<Entry> textures;
+    std::map<GLuint, size_t> buffers;
+    std::map<std::string, Handle> byPath;
+    MipLoader loader;
+
+    static int levelSize(const Entry& e, int level)
+    {
+        int size = e.width > e.height ? e.width : e.height;
+        return size >> level;
+    }
+
+    static size_t levelBytes(const Entry& e, int level)
+    {
+        size_t w = e.width >> level, h = e.height >> level;
+        if (w == 0) w = 1;
+        if (h == 0) h = 1;
+        return w * h * 4;
+    }
+
+    static size_t residentBytes(const Entry& e)
+    {
+        if (e.id == 0)
+            return 0;
+        size_t bytes = 0;
+        for (int level = e.allocLevel; level < e.levels; level++)
+            bytes += levelBytes(e, level);
+        return bytes;
+    }
+
+    void account(Entry& e)
+    {
+        used -= e.bytes;
+        e.bytes = residentBytes(e);
+        used += e.bytes;
+    }
+
+    // zlecenie dekodowania w tle; obiekt tekstury powstaje dopiero w update()
+    void stream(Handle h)
+    {
+        Entry& e = textures[h - 1];
+        e.streaming = true;
+        loader.request(h, e.path);
+    }
+
+    // pusty obiekt tekstury, bez poziomów na GPU (update() ustawia GL_TEXTURE_MAX_LEVEL)
+    void createTexture(Entry& e)
+    {
+        glGenTextures(1, &e.id);
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        e.baseLevel = e.allocLevel = e.levels;
+        e.rowsDone = 0;
+    }
+
+    // wysyłka poziomów od najmniejszego; zwraca niewykorzystaną część budżetu
+    size_t uploadLevels(Entry& e, size_t uploadBudget)
+    {
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        while (e.baseLevel > 0 && uploadBudget > 0)
+        {
+            int level = e.baseLevel - 1;
+            const MipChain::Level& src = e.chain->levels[level];
+            if (e.allocLevel > level)
+            {
+                glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, src.width, src.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+                e.allocLevel = level;
+                e.rowsDone = 0;
+                account(e);
+            }
+
+            size_t rowBytes = (size_t)src.width * 4;
+            size_t rows = uploadBudget / rowBytes;
+            if (rows == 0)
+                rows = 1;
+            if (rows > (size_t)(src.height - e.rowsDone))
+                rows = src.height - e.rowsDone;
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, e.rowsDone, src.width, (GLsizei)rows, GL_RGBA, GL_UNSIGNED_BYTE,
+                &src.pixels[e.rowsDone * rowBytes]);
+            e.rowsDone += (int)rows;
+            uploadBudget = rows * rowBytes < uploadBudget ? uploadBudget - rows * rowBytes : 0;
+
+            if (e.rowsDone == src.height)
+            {
+                // poziom kompletny: odblokowanie próbkowania aż do niego
+                e.baseLevel = level;
+                e.rowsDone = 0;
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+            }
+        }
+        if (e.baseLevel == 0)
+        {
+            e.streaming = false;
+            e.chain.reset();
+        }
+        return uploadBudget;
+    }
+
+    // najdawniej używana tekstura, której nie użyto w bieżącej klatce i która nie jest w trakcie wysyłki
+    Entry* leastRecentlyUsed()
+    {
+        Entry* victim = NULL;
+        for (size_t i = 0; i < textures.size(); i++)
+        {
+            Entry& e = textures[i];
+            if (e.id == 0 || e.streaming || e.lastUse == frame || e.baseLevel >= e.levels)
+                continue;
+            if (victim == NULL || e.lastUse < victim->lastUse)
+                victim = &e;
+        }
+        return victim;
+    }
+
+    // zdjęcie najwyższego poziomu mipmap: podniesienie poziomu bazowego i zwolnienie pamięci poziomu
+    void demote(Entry& e)
+    {
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, e.baseLevel + 1);
+        glTexImage2D(GL_TEXTURE_2D, e.baseLevel, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        e.baseLevel++;
+        e.allocLevel = e.baseLevel;
+        account(e);
+    }
+
+    void evict(Entry& e)
+    {
+        if (e.id)
+            glDeleteTextures(1, &e.id);
+        e.id = 0;
+        e.baseLevel = e.allocLevel = e.levels;
+        e.streaming = false;
+        e.chain.reset();
+        account(e);
+    }
+};
+
+#endif
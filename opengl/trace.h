@@ -0,0 +1,282 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Lekkie śledzenie przebiegu klatki, zapisywane jako Chrome trace JSON
+// (otwierany w https://ui.perfetto.dev lub chrome://tracing).
+//
+//   TRACE_ZONE("nazwa");      // strefa CPU do końca bieżącego bloku
+//   TRACE_GPU_ZONE("nazwa");  // strefa GPU (zapytania GL_TIMESTAMP), tylko w wątku z kontekstem GL
+//   TRACE_GPU_COLLECT();      // raz na klatkę: odczyt gotowych zapytań GPU
+//   TRACE_THREAD_NAME("nazwa"); // nazwa bieżącego wątku w śladzie
+//   TRACE_WRITE("plik.json"); // zapis wszystkich zdarzeń
+//
+// Nazwy muszą być stałymi napisami (zapisywany jest tylko wskaźnik).
+// Bez -DTRACE_ENABLED wszystkie makra są puste i nic nie kosztują.
+// Każdy wątek pisze do własnego bufora pierścieniowego o stałym rozmiarze, bez
+// blokad; po zapełnieniu nowe zdarzenia nadpisują najstarsze, a TRACE_WRITE podaje,
+// ile ich przepadło. Przesunięcie zegara GPU względem CPU jest mierzone co sekundę.
+
+#ifdef TRACE_ENABLED
+
+#include <glad/glad.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace trace
+{
+    struct Event
+    {
+        const char* name;
+        uint64_t start, end; // ns zegara steady_clock
+    };
+
+    struct ThreadBuffer
+    {
+        static const uint32_t CAPACITY = 1 << 16;
+
+        Event events[CAPACITY];
+        std::atomic<uint64_t> count; // wszystkie zapisane zdarzenia; w buforze ostatnie CAPACITY
+        uint32_t tid;
+        const char* name;
+        ThreadBuffer* next;
+    };
+
+    inline uint64_t now()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // lista buforów wszystkich wątków; dopisywanie przez CAS, bez blokad
+    inline std::atomic<ThreadBuffer*>& buffers()
+    {
+        static std::atomic<ThreadBuffer*> head(NULL);
+        return head;
+    }
+
+    inline ThreadBuffer* registerBuffer(uint32_t tid)
+    {
+        ThreadBuffer* buffer = new ThreadBuffer;
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->tid = tid;
+        buffer->name = NULL;
+        buffer->next = buffers().load(std::memory_order_relaxed);
+        while (!buffers().compare_exchange_weak(buffer->next, buffer, std::memory_order_release))
+            ;
+        return buffer;
+    }
+
+    // bufory nie są zwalniane, bo zdarzenia mają przeżyć wątek aż do zapisu
+    inline ThreadBuffer* threadBuffer()
+    {
+        static std::atomic<uint32_t> nextTid(1);
+        static thread_local ThreadBuffer* buffer = registerBuffer(nextTid.fetch_add(1));
+        return buffer;
+    }
+
+    // tylko wątek-właściciel pisze do bufora, więc wystarczy publikacja licznika
+    inline void record(ThreadBuffer* buffer, const char* name, uint64_t start, uint64_t end)
+    {
+        uint64_t i = buffer->count.load(std::memory_order_relaxed);
+        Event& e = buffer->events[i % ThreadBuffer::CAPACITY];
+        e.name = name;
+        e.start = start;
+        e.end = end;
+        buffer->count.store(i + 1, std::memory_order_release);
+    }
+
+    inline void setThreadName(const char* name)
+    {
+        threadBuffer()->name = name;
+    }
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char* zoneName) : name(zoneName), start(now()) {}
+        ~Zone() { record(threadBuffer(), name, start, now()); }
+    private:
+        const char* name;
+        uint64_t start;
+    };
+
+    // strefy GPU: para zapytań GL_TIMESTAMP, odczytywana z opóźnieniem w collectGpu()
+    struct GpuState
+    {
+        static const uint32_t GPU_TID = 0;
+        static const uint64_t RECALIBRATE_NS = 1000000000ull; // zegary GPU i CPU rozjeżdżają się w długim przebiegu
+
+        std::vector<GLuint> freeQueries;
+        struct Pending { const char* name; GLuint begin, end; };
+        std::vector<Pending> pending;
+        int64_t offset;      // czas CPU - czas GPU, w ns
+        bool calibrated;
+        uint64_t calibratedAt;
+        ThreadBuffer* buffer;
+
+        GpuState() : offset(0), calibrated(false), calibratedAt(0), buffer(NULL) {}
+    };
+
+    inline GpuState& gpu()
+    {
+        static GpuState state;
+        return state;
+    }
+
+    // wyrównanie zegara GPU do zegara CPU; glGetInteger64v(GL_TIMESTAMP) zwraca bieżący
+    // czas GPU bez czekania na kolejkę, więc glFinish jest potrzebny tylko za pierwszym razem
+    inline void calibrateGpu()
+    {
+        GpuState& g = gpu();
+        if (!g.calibrated)
+            glFinish();
+        uint64_t before = now();
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        uint64_t after = now();
+        g.offset = (int64_t)(before + (after - before) / 2) - (int64_t)gpuNow;
+        g.calibrated = true;
+        g.calibratedAt = after;
+        if (g.buffer == NULL)
+        {
+            g.buffer = registerBuffer(GpuState::GPU_TID);
+            g.buffer->name = "GPU";
+        }
+    }
+
+    inline GLuint gpuQuery()
+    {
+        GpuState& g = gpu();
+        if (g.freeQueries.empty())
+        {
+            GLuint queries[32];
+            glGenQueries(32, queries);
+            g.freeQueries.assign(queries, queries + 32);
+        }
+        GLuint q = g.freeQueries.back();
+        g.freeQueries.pop_back();
+        return q;
+    }
+
+    class GpuZone
+    {
+    public:
+        explicit GpuZone(const char* zoneName) : name(zoneName)
+        {
+            if (!gpu().calibrated)
+                calibrateGpu();
+            begin = gpuQuery();
+            glQueryCounter(begin, GL_TIMESTAMP);
+        }
+        ~GpuZone()
+        {
+            GLuint end = gpuQuery();
+            glQueryCounter(end, GL_TIMESTAMP);
+            GpuState::Pending p = { name, begin, end };
+            gpu().pending.push_back(p);
+        }
+    private:
+        const char* name;
+        GLuint begin;
+    };
+
+    // odczyt zapytań, które GPU już wykonał (bez czekania)
+    inline void collectGpu()
+    {
+        GpuState& g = gpu();
+        if (g.calibrated && now() - g.calibratedAt > GpuState::RECALIBRATE_NS)
+            calibrateGpu();
+        size_t done = 0;
+        for (; done < g.pending.size(); done++)
+        {
+            GpuState::Pending& p = g.pending[done];
+            GLint available = 0;
+            glGetQueryObjectiv(p.end, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(p.begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(p.end, GL_QUERY_RESULT, &end);
+            record(g.buffer, p.name, begin + g.offset, end + g.offset);
+            g.freeQueries.push_back(p.begin);
+            g.freeQueries.push_back(p.end);
+        }
+        g.pending.erase(g.pending.begin(), g.pending.begin() + done);
+    }
+
+    inline void writeName(FILE* f, const char* name)
+    {
+        for (; *name; name++)
+        {
+            if (*name == '"' || *name == '\\')
+                fputc('\\', f);
+            fputc(*name, f);
+        }
+    }
+
+    inline bool write(const char* path)
+    {
+        FILE* f = fopen(path, "w");
+        if (!f)
+        {
+            printf("Nie udało się zapisać śladu: %s\n", path);
+            return false;
+        }
+        fprintf(f, "{\"traceEvents\":[\n");
+        bool first = true;
+        for (ThreadBuffer* b = buffers().load(std::memory_order_acquire); b; b = b->next)
+        {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", b->tid, b->name ? b->name : "wątek");
+            first = false;
+            // wątek może dalej pisać: zdarzenia, które mógł w tym czasie nadpisać, są pomijane
+            uint64_t count = b->count.load(std::memory_order_acquire);
+            uint64_t begin = count > ThreadBuffer::CAPACITY ? count - ThreadBuffer::CAPACITY : 0;
+            for (uint64_t i = begin; i < count; i++)
+            {
+                const Event e = b->events[i % ThreadBuffer::CAPACITY];
+                if (b->count.load(std::memory_order_acquire) >= i + ThreadBuffer::CAPACITY)
+                    continue;
+                fprintf(f, ",\n{\"name\":\"");
+                writeName(f, e.name);
+                fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    b->tid, e.start / 1000.0, (e.end - e.start) / 1000.0);
+            }
+        }
+        fprintf(f, "\n]}\n");
+        fclose(f);
+
+        for (ThreadBuffer* b = buffers().load(std::memory_order_acquire); b; b = b->next)
+        {
+            uint64_t count = b->count.load(std::memory_order_acquire);
+            if (count > ThreadBuffer::CAPACITY)
+                printf("Ślad: wątek %s: %llu najstarszych zdarzeń nadpisanych (bufor na %u)\n",
+                    b->name ? b->name : "bez nazwy", (unsigned long long)(count - ThreadBuffer::CAPACITY),
+                    ThreadBuffer::CAPACITY);
+        }
+        return true;
+    }
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(name) trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_GPU_ZONE(name) trace::GpuZone TRACE_CONCAT(traceGpuZone, __LINE__)(name)
+#define TRACE_GPU_COLLECT() trace::collectGpu()
+#define TRACE_THREAD_NAME(name) trace::setThreadName(name)
+#define TRACE_WRITE(path) trace::write(path)
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_GPU_ZONE(name) ((void)0)
+#define TRACE_GPU_COLLECT() ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_WRITE(path) ((void)0)
+
+#endif
+
+#endif
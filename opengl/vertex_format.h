@@ -0,0 +1,287 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <glad/glad.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Formaty wierzchołków opisane w czasie kompilacji.
+//
+// Wierzchołek to zwykła struktura, a VertexLayout<V>::attribs opisuje jej atrybuty
+// (lokalizacja, liczba składowych, typ GL, normalizacja, przesunięcie). Z tego opisu
+// setupVertexAttribs<V>() ustawia VAO, z krokiem sizeof(V), bez ręcznie liczonych
+// "5 * sizeof(float)". static_assert sprawdza, że każdy atrybut mieści się w strukturze,
+// jest wyrównany do 4 bajtów i ma rozmiar zgodny z typem GL.
+//
+// Formaty upakowane (wszystkie z rdzenia GL 3.3):
+//   GL_HALF_FLOAT                    - współrzędne tekstury w 16-bitowych floatach
+//   GL_UNSIGNED_SHORT, znormalizowane - współrzędne tekstury z zakresu [0, 1]
+//   GL_INT_2_10_10_10_REV            - normalne, 10 bitów na składową w jednym słowie
+//   GL_UNSIGNED_BYTE, znormalizowane - kolory RGBA8
+namespace vertex
+{
+    struct Attrib
+    {
+        GLuint location;
+        GLint components;
+        GLenum type;
+        GLboolean normalized;
+        size_t offset;
+    };
+
+    // specjalizacja dla każdego formatu, poza strukturą (offsetof wymaga pełnego typu).
+    // Specjalizacje są częściowe (po parametrze Unused), więc attribs pozostaje składową
+    // szablonu: przed C++17 (bez zmiennych inline) jej definicja poza klasą może stać
+    // w nagłówku dołączanym do wielu plików .cpp. Wymagany jest co najmniej C++14.
+    template <typename V, typename Unused = void>
+    struct VertexLayout;
+
+    constexpr size_t typeBytes(GLenum type)
+    {
+        return type == GL_FLOAT || type == GL_INT || type == GL_UNSIGNED_INT ? 4
+            : type == GL_HALF_FLOAT || type == GL_SHORT || type == GL_UNSIGNED_SHORT ? 2
+            : type == GL_BYTE || type == GL_UNSIGNED_BYTE ? 1
+            : 0;
+    }
+
+    constexpr bool isPacked(GLenum type)
+    {
+        return type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV;
+    }
+
+    constexpr size_t attribBytes(const Attrib& a)
+    {
+        return isPacked(a.type) ? 4 : a.components * typeBytes(a.type);
+    }
+
+    constexpr bool validAttrib(const Attrib& a, size_t vertexSize)
+    {
+        return a.components >= 1 && a.components <= 4
+            && (!isPacked(a.type) || a.components == 4)
+            && attribBytes(a) > 0
+            && a.offset % 4 == 0
+            && a.offset + attribBytes(a) <= vertexSize;
+    }
+
+    template <typename V>
+    constexpr bool validLayout()
+    {
+        const size_t count = sizeof(VertexLayout<V>::attribs) / sizeof(Attrib);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!validAttrib(VertexLayout<V>::attribs[i], sizeof(V)))
+                return false;
+            for (size_t j = 0; j < i; j++)
+                if (VertexLayout<V>::attribs[i].location == VertexLayout<V>::attribs[j].location)
+                    return false;
+        }
+        return sizeof(V) % 4 == 0;
+    }
+
+    // atrybuty formatu V w aktualnie powiązanym VAO, z danych aktualnego GL_ARRAY_BUFFER
+    template <typename V>
+    void setupVertexAttribs(size_t baseOffset = 0)
+    {
+        static_assert(validLayout<V>(), "nieprawidłowy opis formatu wierzchołka");
+        const size_t count = sizeof(VertexLayout<V>::attribs) / sizeof(Attrib);
+        for (size_t i = 0; i < count; i++)
+        {
+            const Attrib& a = VertexLayout<V>::attribs[i];
+            glVertexAttribPointer(a.location, a.components, a.type, a.normalized, sizeof(V), (void*)(baseOffset + a.offset));
+            glEnableVertexAttribArray(a.location);
+        }
+    }
+
+    // nowe VAO dla bufora z wierzchołkami formatu V
+    template <typename V>
+    GLuint createVertexArray(GLuint VBO)
+    {
+        GLuint VAO;
+        glGenVertexArrays(1, &VAO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        setupVertexAttribs<V>();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+        return VAO;
+    }
+
+    // float -> half (IEEE 754 binary16), zaokrąglenie do najbliższej
+    inline uint16_t toHalf(float value)
+    {
+        uint32_t f;
+        memcpy(&f, &value, sizeof(f));
+        uint32_t sign = (f >> 16) & 0x8000;
+        int32_t exponent = (int32_t)((f >> 23) & 0xFF) - 127 + 15;
+        uint32_t mantissa = f & 0x7FFFFF;
+        if (((f >> 23) & 0xFF) == 0xFF) // inf / NaN
+            return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+        if (exponent >= 31)
+            return (uint16_t)(sign | 0x7C00);
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+                return (uint16_t)sign;
+            mantissa |= 0x800000;
+            uint32_t shift = (uint32_t)(14 - exponent);
+            uint32_t half = mantissa >> shift;
+            uint32_t rest = mantissa & ((1u << shift) - 1);
+            uint32_t halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1)))
+                half++;
+            return (uint16_t)(sign | half);
+        }
+        uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+        uint32_t rest = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+            half++; // przeniesienie do wykładnika daje poprawny wynik, łącznie z inf
+        return (uint16_t)half;
+    }
+
+    inline float clampf(float v, float lo, float hi)
+    {
+        return v < lo ? lo : (v > hi ? hi : v);
+    }
+
+    // [0, 1] -> znormalizowany unsigned short
+    inline uint16_t toUnorm16(float value)
+    {
+        return (uint16_t)std::lround(clampf(value, 0.0f, 1.0f) * 65535.0f);
+    }
+
+    // [0, 1] -> znormalizowany unsigned byte
+    inline uint8_t toUnorm8(float value)
+    {
+        return (uint8_t)std::lround(clampf(value, 0.0f, 1.0f) * 255.0f);
+    }
+
+    // wektor z [-1, 1] -> GL_INT_2_10_10_10_REV (x w najmłodszych bitach, w w dwóch najstarszych)
+    inline uint32_t toSnorm2_10_10_10(float x, float y, float z, float w = 0.0f)
+    {
+        uint32_t ix = (uint32_t)std::lround(clampf(x, -1.0f, 1.0f) * 511.0f) & 0x3FF;
+        uint32_t iy = (uint32_t)std::lround(clampf(y, -1.0f, 1.0f) * 511.0f) & 0x3FF;
+        uint32_t iz = (uint32_t)std::lround(clampf(z, -1.0f, 1.0f) * 511.0f) & 0x3FF;
+        uint32_t iw = (uint32_t)std::lround(clampf(w, -1.0f, 1.0f)) & 0x3;
+        return ix | (iy << 10) | (iz << 20) | (iw << 30);
+    }
+
+    // sama pozycja (triangle.cpp): 12 bajtów
+    struct PositionVertex
+    {
+        float position[3];
+    };
+
+    // pozycja na płaszczyźnie (kontur i ziarna w hourglass.cpp): 8 bajtów
+    struct Position2DVertex
+    {
+        float position[2];
+    };
+
+    // pozycja i współrzędne tekstury w floatach, jak dotąd w texture.cpp i hous.cpp: 20 bajtów
+    struct TexturedVertex
+    {
+        float position[3];
+        float uv[2];
+    };
+
+    // pozycja w floatach, współrzędne tekstury w half: 16 bajtów
+    struct CompactTexturedVertex
+    {
+        float position[3];
+        uint16_t uv[2];
+
+        static CompactTexturedVertex pack(const float* position, const float* uv)
+        {
+            CompactTexturedVertex v;
+            memcpy(v.position, position, sizeof(v.position));
+            v.uv[0] = toHalf(uv[0]);
+            v.uv[1] = toHalf(uv[1]);
+            return v;
+        }
+    };
+
+    // pełny wierzchołek oświetlanej siatki z teksturą: 24 bajty zamiast 48 w samych floatach
+    // (uv jako znormalizowane 16 bitów, więc tylko z zakresu [0, 1], bez powtarzania tekstury)
+    struct PackedVertex
+    {
+        float position[3];
+        uint16_t uv[2];
+        uint32_t normal;
+        uint8_t color[4];
+
+        static PackedVertex pack(const float* position, const float* uv, const float* normal, const float* color)
+        {
+            PackedVertex v;
+            memcpy(v.position, position, sizeof(v.position));
+            v.uv[0] = toUnorm16(uv[0]);
+            v.uv[1] = toUnorm16(uv[1]);
+            v.normal = toSnorm2_10_10_10(normal[0], normal[1], normal[2]);
+            for (int i = 0; i < 4; i++)
+                v.color[i] = toUnorm8(color[i]);
+            return v;
+        }
+    };
+
+    template <typename Unused>
+    struct VertexLayout<PositionVertex, Unused>
+    {
+        static constexpr Attrib attribs[] = {
+            { 0, 3, GL_FLOAT, GL_FALSE, offsetof(PositionVertex, position) },
+        };
+    };
+
+    template <typename Unused>
+    struct VertexLayout<Position2DVertex, Unused>
+    {
+        static constexpr Attrib attribs[] = {
+            { 0, 2, GL_FLOAT, GL_FALSE, offsetof(Position2DVertex, position) },
+        };
+    };
+
+    template <typename Unused>
+    struct VertexLayout<TexturedVertex, Unused>
+    {
+        static constexpr Attrib attribs[] = {
+            { 0, 3, GL_FLOAT, GL_FALSE, offsetof(TexturedVertex, position) },
+            { 1, 2, GL_FLOAT, GL_FALSE, offsetof(TexturedVertex, uv) },
+        };
+    };
+
+    template <typename Unused>
+    struct VertexLayout<CompactTexturedVertex, Unused>
+    {
+        static constexpr Attrib attribs[] = {
+            { 0, 3, GL_FLOAT, GL_FALSE, offsetof(CompactTexturedVertex, position) },
+            { 1, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(CompactTexturedVertex, uv) },
+        };
+    };
+
+    template <typename Unused>
+    struct VertexLayout<PackedVertex, Unused>
+    {
+        static constexpr Attrib attribs[] = {
+            { 0, 3, GL_FLOAT, GL_FALSE, offsetof(PackedVertex, position) },
+            { 1, 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedVertex, uv) },
+            { 2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(PackedVertex, normal) },
+            { 3, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(PackedVertex, color) },
+        };
+    };
+
+    // definicje tablic attribs dla C++14 (od C++17 składowe constexpr są inline)
+#if __cplusplus < 201703L
+    template <typename Unused> constexpr Attrib VertexLayout<PositionVertex, Unused>::attribs[];
+    template <typename Unused> constexpr Attrib VertexLayout<Position2DVertex, Unused>::attribs[];
+    template <typename Unused> constexpr Attrib VertexLayout<TexturedVertex, Unused>::attribs[];
+    template <typename Unused> constexpr Attrib VertexLayout<CompactTexturedVertex, Unused>::attribs[];
+    template <typename Unused> constexpr Attrib VertexLayout<PackedVertex, Unused>::attribs[];
+#endif
+
+    static_assert(sizeof(Position2DVertex) == 8, "Position2DVertex: 8 bajtów");
+    static_assert(sizeof(TexturedVertex) == 20, "TexturedVertex: 20 bajtów");
+    static_assert(sizeof(CompactTexturedVertex) == 16, "CompactTexturedVertex: 16 bajtów");
+    static_assert(sizeof(PackedVertex) == 24, "PackedVertex: 24 bajty");
+}
+
+#endif
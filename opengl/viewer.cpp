@@ -0,0 +1,268 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <stb_image.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "host.h"
+#include "scenes.h"
+#include "startup.h"
+#include "trace.h"
+
+// Kilka scen w jednym procesie, każda w osobnym oknie i osobnym wątku renderującym.
+//
+//   viewer [triangle] [hourglass] [texture] [hous] ...   (domyślnie wszystkie)
+//
+// Sceny są te same co w programach triangle, hourglass, texture i hous (scenes.h).
+// Ukryte okno główne ma kontekst, w którym raz powstaje wspólna część każdej sceny:
+// shadery, bufory i tekstury. Okna widoków tworzą konteksty współdzielące z nim
+// obiekty, więc kolejny widok (także tej samej sceny) kosztuje tylko okno i własny
+// widok sceny (VAO, stan klatki), a nie ponowną kompilację shaderów i wczytanie
+// tekstur. Wątek główny obsługuje zdarzenia okien (GLFW tego wymaga), a każdy widok
+// rysuje i przełącza bufory we własnym wątku.
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+
+// ustawienia
+const unsigned int VIEW_WIDTH = 400;
+const unsigned int VIEW_HEIGHT = 300;
+// ile bajtów tekstur wysyłać na GPU w jednym przebiegu pętli przy starcie
+const size_t STARTUP_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+// okno jednej sceny; rozmiar ustawia wątek główny, czyta wątek widoku
+struct View
+{
+    Scene* scene;
+    GLFWwindow* window;
+    std::atomic<int> width, height;
+    std::atomic<bool> running;
+    std::thread thread;
+};
+
+void renderView(View* view, TextureManager* textures)
+{
+    TRACE_THREAD_NAME(view->scene->title());
+    glfwMakeContextCurrent(view->window);
+    glfwSwapInterval(1);
+    // inny kontekst niż główny: widok tylko czyta menedżer tekstur
+    SceneView* sceneView = view->scene->createView(*textures, true);
+
+    while (sceneView && view->running.load(std::memory_order_relaxed))
+    {
+        TRACE_ZONE("klatka");
+        sceneView->update();
+        glViewport(0, 0, view->width.load(std::memory_order_relaxed), view->height.load(std::memory_order_relaxed));
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        sceneView->draw(*textures);
+        glfwSwapBuffers(view->window);
+    }
+
+    if (sceneView)
+    {
+        sceneView->destroy(*textures);
+        delete sceneView;
+    }
+    glfwMakeContextCurrent(NULL);
+}
+
+int main(int argc, char** argv)
+{
+    TRACE_THREAD_NAME("main");
+
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; i++)
+        names.push_back(argv[i]);
+    if (names.empty())
+    {
+        names.push_back("triangle");
+        names.push_back("hourglass");
+        names.push_back("texture");
+        names.push_back("hous");
+    }
+    // jedna scena na nazwę, niezależnie od liczby jej widoków
+    std::map<std::string, Scene*> scenes;
+    std::vector<Scene*> viewScenes;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        Scene*& scene = scenes[names[i]];
+        if (scene == NULL)
+            scene = createScene(names[i]);
+        if (scene == NULL)
+        {
+            std::cout << "Nieznana scena: " << names[i] << std::endl;
+            for (std::map<std::string, Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+                delete it->second;
+            return -1;
+        }
+        viewScenes.push_back(scene);
+    }
+
+    // menedżer tekstur wspólny dla wszystkich scen (GPU_BUDGET_MB nadpisuje budżet)
+    size_t budgetMB = GPU_BUDGET_MB;
+    if (const char* env = getenv("GPU_BUDGET_MB"))
+        budgetMB = strtoul(env, NULL, 10);
+    TextureManager textures(budgetMB * 1024 * 1024);
+    stbi_set_flip_vertically_on_load(true);
+
+    // start jako graf zależności (startup.h), z czasami poszczególnych etapów;
+    // część scen bez GL (pliki, dekodowanie tekstur) rusza w tle od razu,
+    // równolegle z tworzeniem okien
+    StartupGraph startup;
+
+    GLFWwindow* root = NULL;
+    StartupGraph::Task context = startup.add("okno główne i kontekst", StartupGraph::MAIN, [&]
+    {
+        // ukryte okno z kontekstem na wspólne zasoby
+        root = createWindow(1, 1, "Viewer", 33, NULL, false);
+        if (root == NULL)
+        {
+            std::cout << "Nie udało się utworzyć okna GLFW" << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    // część scen bez GL po kolei w jednym zadaniu: menedżer tekstur przyjmuje
+    // zlecenia tylko z jednego wątku naraz
+    StartupGraph::Task prepared = startup.add("przygotowanie scen", StartupGraph::WORKER, [&]
+    {
+        for (std::map<std::string, Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+            if (!it->second->prepare(textures))
+                return false;
+        return true;
+    });
+
+    // wspólne części scen: raz na scenę, niezależnie od liczby widoków, i w całości,
+    // bo widoki w innych kontekstach nie doczytują kolejnych części
+    // -----------------------------------------------------------
+    // graf trzyma same wskaźniki nazw zadań, więc napisy muszą przeżyć start
+    std::vector<std::string> taskNames;
+    taskNames.reserve(scenes.size());
+    StartupGraph::Task resources = context;
+    for (std::map<std::string, Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+    {
+        Scene* scene = it->second;
+        taskNames.push_back("zasoby: " + it->first);
+        resources = startup.add(taskNames.back().c_str(), StartupGraph::MAIN, [&textures, scene]
+        {
+            if (!scene->create(textures))
+                return false;
+            while (!scene->complete())
+                scene->loadMore(textures);
+            return true;
+        }, { prepared, resources });
+    }
+
+    // okna widoków, współdzielące obiekty z oknem głównym
+    // --------------------------------------------------
+    std::vector<View*> views;
+    StartupGraph::Task windows = startup.add("okna widoków", StartupGraph::MAIN, [&]
+    {
+        for (size_t i = 0; i < viewScenes.size(); i++)
+        {
+            GLFWwindow* window = createWindow(VIEW_WIDTH, VIEW_HEIGHT, viewScenes[i]->title(), 33, root);
+            if (window == NULL)
+            {
+                std::cout << "Nie udało się utworzyć okna GLFW" << std::endl;
+                break;
+            }
+            View* view = new View;
+            view->scene = viewScenes[i];
+            view->window = window;
+            int width, height;
+            glfwGetFramebufferSize(window, &width, &height);
+            view->width = width;
+            view->height = height;
+            view->running = true;
+            glfwSetWindowUserPointer(window, view);
+            glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+            views.push_back(view);
+        }
+        return true;
+    }, { context });
+
+    // tekstury muszą być kompletne, zanim inne konteksty zaczną z nich korzystać:
+    // po starcie wątków widoków menedżer nie może już zmieniać obiektów
+    // -----------------------------------------------------------------
+    StartupGraph::Task upload = startup.add("wysyłka tekstur", StartupGraph::MAIN, [&]
+    {
+        while (!textures.idle())
+        {
+            textures.update(STARTUP_UPLOAD_BUDGET);
+            glfwPollEvents();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // zmiany z jednego kontekstu są widoczne w innych dopiero po ich zakończeniu
+        glFinish();
+        return true;
+    }, { resources, windows });
+
+    startup.start();
+    if (!startup.run(upload))
+    {
+        for (std::map<std::string, Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+            delete it->second;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(NULL);
+
+    for (size_t i = 0; i < views.size(); i++)
+        views[i]->thread = std::thread(renderView, views[i], &textures);
+
+    startup.mark("start wątków widoków");
+    startup.printTimings();
+
+    // pętla zdarzeń; okno zamknięte przez użytkownika zatrzymuje tylko swój widok
+    // --------------------------------------------------------------------------
+    size_t open = views.size();
+    while (open > 0)
+    {
+        glfwWaitEventsTimeout(0.1);
+        for (size_t i = 0; i < views.size(); i++)
+        {
+            View* view = views[i];
+            if (view->window == NULL)
+                continue;
+            processInput(view->window);
+            if (!glfwWindowShouldClose(view->window))
+                continue;
+            view->running = false;
+            view->thread.join();
+            glfwDestroyWindow(view->window);
+            view->window = NULL;
+            open--;
+        }
+    }
+    TRACE_WRITE("viewer_trace.json");
+
+    // glfw: usunięcie wspólnych zasobów i zwolnienie pamięci
+    // ------------------------------------------------------------------
+    glfwMakeContextCurrent(root);
+    textures.printStats();
+    for (std::map<std::string, Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+    {
+        it->second->destroy(textures);
+        delete it->second;
+    }
+    textures.destroy();
+    for (size_t i = 0; i < views.size(); i++)
+        delete views[i];
+
+    glfwTerminate();
+    return 0;
+}
+
+// glfw: zmiana rozmiaru okna; viewport ustawia wątek widoku, który ma jego kontekst
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    View* view = (View*)glfwGetWindowUserPointer(window);
+    view->width = width;
+    view->height = height;
+}
@@ -0,0 +1,114 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "trace.h"
+
+// Stała pula wątków do równoległych pętli.
+//
+//   pool.parallelFor(n, 4096, [&](size_t begin, size_t end) { ... });
+//
+// Zakres jest dzielony na porcje po `grain` elementów, pobierane licznikiem
+// atomowym przez wątki puli i przez wątek wywołujący; parallelFor wraca, gdy
+// wszystkie porcje są gotowe. Wywołania nie mogą się zagnieżdżać.
+class WorkerPool
+{
+public:
+    // threads = łączna liczba wątków razem z wywołującym; 0 = liczba rdzeni
+    explicit WorkerPool(unsigned threads = 0) : count(0), grain(1), next(0), busy(0), generation(0), quit(false)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 1; i < threads; i++)
+            workers.push_back(std::thread(&WorkerPool::run, this));
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        start.notify_all();
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+    }
+
+    unsigned size() const { return (unsigned)workers.size() + 1; }
+
+    void parallelFor(size_t n, size_t grainSize, const std::function<void(size_t, size_t)>& fn)
+    {
+        if (n == 0)
+            return;
+        if (workers.empty() || n <= grainSize)
+        {
+            fn(0, n);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = fn;
+            count = n;
+            grain = grainSize > 0 ? grainSize : 1;
+            next.store(0);
+            busy = (unsigned)workers.size();
+            generation++;
+        }
+        start.notify_all();
+        work();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busy == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start, done;
+    std::function<void(size_t, size_t)> job;
+    size_t count, grain;
+    std::atomic<size_t> next;
+    unsigned busy;
+    unsigned long long generation;
+    bool quit;
+
+    void work()
+    {
+        for (;;)
+        {
+            size_t begin = next.fetch_add(grain);
+            if (begin >= count)
+                return;
+            job(begin, std::min(begin + grain, count));
+        }
+    }
+
+    void run()
+    {
+        TRACE_THREAD_NAME("WorkerPool");
+        unsigned long long seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [&] { return quit || generation != seen; });
+                if (quit)
+                    return;
+                seen = generation;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+};
+
+#endif